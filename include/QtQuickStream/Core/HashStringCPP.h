@@ -5,6 +5,8 @@
 
 /*! ***********************************************************************************************
  * HashStringCPP hash string and compare two hash string (Md5 method).
+ *
+ * hash64() is a fast non-cryptographic hash (XXH64) used for content hashes of objects.
  * ************************************************************************************************/
 class HashStringCPP : public QObject
 {
@@ -18,6 +20,15 @@ public:
      * ****************************************************************************************/
     explicit HashStringCPP(QObject *parent = nullptr);
 
+    /* Public Static Functions
+     * ****************************************************************************************/
+
+    //! Hash data with XXH64
+    static quint64 hash64(const QByteArray &data, quint64 seed = 0);
+
+    //! Hex representation of a 64 bit hash (16 characters)
+    static QString toHex64(quint64 hash);
+
 protected slots:
     /* Protected Slots
      * ****************************************************************************************/
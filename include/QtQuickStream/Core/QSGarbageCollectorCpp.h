@@ -0,0 +1,108 @@
+#ifndef QSGARBAGECOLLECTORCPP_H
+#define QSGARBAGECOLLECTORCPP_H
+
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+#include <qqml.h>
+
+class QSRepositoryCpp;
+
+/*! ***********************************************************************************************
+ * QSGarbageCollectorCpp finds the objects of a QSRepositoryCpp that cannot be reached from its
+ * qsRootObject (or a pinned object) by following qqs:/ references, and optionally deletes them.
+ *
+ * The mark-and-sweep runs in time slices of sliceMs on the event loop, so it does not stall the UI.
+ * References added while marking are caught by a write barrier (see shade()), and objects added
+ * while collecting are never swept.
+ *
+ * \note    Reachability is based on the reference index of the repository, i.e., references in
+ *          properties without xxxChanged() notification are only seen after updateReferences()
+ * \note    Deleted objects owned by the repository (e.g., created when loading) are destroyed
+ * ************************************************************************************************/
+class QSGarbageCollectorCpp : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool         isRunning       READ isRunning          NOTIFY isRunningChanged)
+    Q_PROPERTY(int          sliceMs         READ getSliceMs         WRITE setSliceMs NOTIFY sliceMsChanged)
+    Q_PROPERTY(QStringList  pinnedIds       READ getPinnedIds       NOTIFY pinnedIdsChanged)
+    Q_PROPERTY(QStringList  unreachableIds  READ getUnreachableIds  NOTIFY finished)
+    QML_ELEMENT
+    QML_UNCREATABLE("QSGarbageCollectorCpp is provided by QSRepositoryCpp")
+
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit QSGarbageCollectorCpp(QSRepositoryCpp *repo);
+
+    /* Public Getters & Setters
+     * ****************************************************************************************/
+    bool                isRunning           () const;
+    int                 getSliceMs          () const;
+    QStringList         getPinnedIds        () const;
+    QStringList         getUnreachableIds   () const;
+
+    void                setSliceMs          (int sliceMs);
+
+    /* Public Functions (called by the repository)
+     * ****************************************************************************************/
+    void                shade               (const QStringList &targetIds);
+
+public slots:
+    /* Public Slots
+     * ****************************************************************************************/
+    void                pin                 (const QString &uuidStr);
+    void                unpin               (const QString &uuidStr);
+
+    bool                start               (bool deleteUnreachable = false);
+    QStringList         collect             (bool deleteUnreachable = false);
+    void                cancel              ();
+
+signals:
+    /* Signals
+     * ****************************************************************************************/
+    void                isRunningChanged();
+    void                sliceMsChanged();
+    void                pinnedIdsChanged();
+    void                finished(const QStringList &unreachableIds, int deletedCount);
+
+private slots:
+    /* Private Slots
+     * ****************************************************************************************/
+    void                runSlice            ();
+
+private:
+    /* Private Types
+     * ****************************************************************************************/
+    enum Phase { Idle, Marking, Sweeping };
+
+    /* Private Functions
+     * ****************************************************************************************/
+    bool                begin               (bool deleteUnreachable);
+    bool                step                ();
+    void                finish              ();
+    void                markGray            (const QString &uuidStr);
+
+    /* Attributes
+     * ****************************************************************************************/
+    QSRepositoryCpp    *m_repo;
+    QTimer              m_timer;
+    int                 m_sliceMs;
+
+    QSet<QString>       m_pinnedIds;
+    QStringList         m_unreachableIds;
+
+    Phase               m_phase;
+    bool                m_deleteUnreachable;
+
+    //! Objects present when collecting started (only these can be swept)
+    QSet<QString>       m_candidateIds;
+    QSet<QString>       m_markedIds;
+    QStringList         m_grayIds;
+
+    QStringList         m_sweepIds;
+    qsizetype           m_sweepIndex;
+};
+
+#endif // QSGARBAGECOLLECTORCPP_H
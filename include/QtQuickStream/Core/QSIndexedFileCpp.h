@@ -0,0 +1,76 @@
+#ifndef QSINDEXEDFILECPP_H
+#define QSINDEXEDFILECPP_H
+
+#include <QFile>
+#include <QHash>
+#include <QTemporaryFile>
+#include <QVariantMap>
+
+/*! ***********************************************************************************************
+ * QSIndexedFileCpp reads and writes repositories in an indexed layout, so single objects can be
+ * read without parsing the whole file:
+ *
+ *      QQSIDX1\n                   magic
+ *      <header size>\n             size of the header in bytes (decimal)
+ *      <header>                    JSON: { "meta": {...}, "index": { UUID: [offset, size] } }
+ *      <objects>                   compact JSON of all objects, offsets relative to this section
+ *
+ * "meta" holds all non-object entries of QSRepository.dumpRepo() (root, version, application).
+ *
+ * Objects can be evicted back to disk: their current state is appended to a swap file and the
+ * index entry is redirected to it.
+ * ************************************************************************************************/
+class QSIndexedFileCpp
+{
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    QSIndexedFileCpp();
+
+    /* Public Functions
+     * ****************************************************************************************/
+    bool                open        (const QString &fileName);
+    void                close       ();
+
+    bool                isOpen      () const;
+    QString             fileName    () const;
+    QVariantMap         meta        () const;
+    QStringList         objectIds   () const;
+    bool                contains    (const QString &uuidStr) const;
+    bool                isSwapped   (const QString &uuidStr) const;
+
+    QByteArray          readRaw     (const QString &uuidStr);
+    QVariantMap         read        (const QString &uuidStr);
+    bool                evict       (const QString &uuidStr, const QVariantMap &qsProps);
+    bool                evictRaw    (const QString &uuidStr, const QByteArray &data);
+
+    /* Public Static Functions
+     * ****************************************************************************************/
+    static bool         isIndexedFile   (const QString &fileName);
+    static bool         write           (const QString &fileName, const QVariantMap &meta,
+                                         const QHash<QString, QByteArray> &objects);
+
+    /* Public Static Attributes
+     * ****************************************************************************************/
+    static const QByteArray magic;
+
+private:
+    /* Private Types
+     * ****************************************************************************************/
+    struct Entry {
+        qint64  offset  = 0;
+        qint64  size    = 0;
+        bool    swapped = false;
+    };
+
+    /* Attributes
+     * ****************************************************************************************/
+    QFile                   m_file;
+    QTemporaryFile          m_swapFile;
+    qint64                  m_dataOffset;
+
+    QVariantMap             m_meta;
+    QHash<QString, Entry>   m_index;
+};
+
+#endif // QSINDEXEDFILECPP_H
@@ -0,0 +1,93 @@
+#ifndef QSMUTATIONRECORDERCPP_H
+#define QSMUTATIONRECORDERCPP_H
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonObject>
+#include <QObject>
+#include <QUrl>
+#include <qqml.h>
+
+class QSObjectCpp;
+class QSRepositoryCpp;
+
+/*! ***********************************************************************************************
+ * QSMutationRecorderCpp records the mutations of a QSRepositoryCpp (object additions, deletions,
+ * property changes and loading) as timestamped trace, e.g., to replay a real edit session with
+ * QSMutationReplayer (see 'qqstool replay').
+ *
+ * The trace is a JSON Lines file. The first line holds the repo when recording started, every
+ * other line is a single mutation with its time in microseconds since the start:
+ *
+ *      { "qsTrace": 1, "name": "Repo", "root": "qqs:/UUID", "objects": { UUID: qsProps, ... } }
+ *      { "t": 1042, "op": "add",    "id": UUID, "props": qsProps }
+ *      { "t": 2210, "op": "change", "id": UUID, "prop": "x", "value": 42 }
+ *      { "t": 3005, "op": "delete", "id": UUID }
+ *      { "t": 4100, "op": "beginLoad" }, { "t": 4900, "op": "endLoad" }
+ *
+ * Values are stored as by QSSerializerCpp::getQSProp(), i.e., references as qqs:/UUID.
+ *
+ * \note    Disabled by default, as every mutation is serialized and written while recording
+ * ************************************************************************************************/
+class QSMutationRecorderCpp : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool         isRecording READ isRecording    NOTIFY isRecordingChanged)
+    QML_ELEMENT
+    QML_UNCREATABLE("QSMutationRecorderCpp is provided by QSRepositoryCpp")
+
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit QSMutationRecorderCpp(QSRepositoryCpp *repo);
+
+    /* Public Getters
+     * ****************************************************************************************/
+    bool                isRecording     () const;
+
+    /* Public Functions (called by the repository)
+     * ****************************************************************************************/
+    void                recordAdded     (const QString &uuidStr, QSObjectCpp *qsObject);
+    void                recordDeleted   (const QString &uuidStr);
+    void                recordChanged   (QSObjectCpp *qsObject, int propertyIndex);
+
+    /* Public Static Attributes
+     * ****************************************************************************************/
+    //! Version of the trace format (stored in the first line)
+    static const int    traceVersion;
+
+public slots:
+    /* Public Slots
+     * ****************************************************************************************/
+    bool                start           (const QString &fileName);
+    bool                start           (const QUrl &fileUrl);
+    void                stop            ();
+
+    qint64              getEventCount   () const;
+
+signals:
+    /* Signals
+     * ****************************************************************************************/
+    void                isRecordingChanged();
+
+private slots:
+    /* Private Slots
+     * ****************************************************************************************/
+    void                onIsLoadingChanged();
+
+private:
+    /* Private Functions
+     * ****************************************************************************************/
+    void                writeLine       (const QJsonObject &line);
+    void                writeEvent      (const QString &op, QJsonObject &&event);
+
+    /* Attributes
+     * ****************************************************************************************/
+    QSRepositoryCpp    *m_repo;
+
+    QFile               m_file;
+    QElapsedTimer       m_timer;
+    qint64              m_eventCount;
+};
+
+#endif // QSMUTATIONRECORDERCPP_H
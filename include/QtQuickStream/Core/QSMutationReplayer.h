@@ -0,0 +1,87 @@
+#ifndef QSMUTATIONREPLAYER_H
+#define QSMUTATIONREPLAYER_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QVariantMap>
+
+#include <functional>
+
+class QSObjectCpp;
+class QSRepositoryCpp;
+
+/*! ***********************************************************************************************
+ * QSMutationReplayer re-executes a trace of QSMutationRecorderCpp against a repository as fast as
+ * possible (ignoring the recorded times), and reports throughput and latency per operation kind:
+ *
+ *      { "operations": 1200, "elapsedMs": 35.2, "opsPerSecond": 34090,
+ *        "kinds": { "change": { "count": 1000, "opsPerSecond": .., "meanUs": .., "p50Us": ..,
+ *                               "p90Us": .., "p99Us": .., "maxUs": .. }, ... } }
+ *
+ * Only the repository work of an operation is timed: registering/unregistering the object, or
+ * writing the property (including the repo's reaction to the change signal). Creating objects and
+ * decoding values are not.
+ *
+ * Objects are created by the factory, by default through the meta type of their qsType (C++ types
+ * with a Q_INVOKABLE constructor) or as plain QSObjectCpp holding dynamic properties. Changes of
+ * dynamic properties are reported to the repo with notifyObjectChanged().
+ *
+ * \note    Replaying needs no QML engine, but QML types can only be replayed with a factory that
+ *          creates them (e.g., from a QQmlComponent)
+ * ************************************************************************************************/
+class QSMutationReplayer
+{
+public:
+    /* Public Types
+     * ****************************************************************************************/
+    //! Returns a new object of qsType (ownership is taken by the replayer)
+    using Factory = std::function<QSObjectCpp*(const QString &qsType)>;
+
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    QSMutationReplayer();
+
+    /* Public Functions
+     * ****************************************************************************************/
+    bool                load            (const QString &fileName, QString *errorString = nullptr);
+
+    void                setFactory      (const Factory &factory);
+
+    qsizetype           eventCount      () const;
+    QVariantMap         replay          (QSRepositoryCpp *repo);
+
+    /* Public Static Functions
+     * ****************************************************************************************/
+    static QSObjectCpp *createObject    (const QString &qsType);
+
+private:
+    /* Private Types
+     * ****************************************************************************************/
+    struct Event {
+        QString     op;
+        QString     uuidStr;
+        QString     propName;
+        QVariant    value;          //!< Value of propName, or all properties (add, change all)
+    };
+
+    /* Private Functions
+     * ****************************************************************************************/
+    QSObjectCpp        *addObject       (QSRepositoryCpp *repo, const QString &uuidStr,
+                                         const QVariantMap &qsProps);
+    qint64              applyEvent      (QSRepositoryCpp *repo, const Event &event);
+
+    static QVariant     resolveValue    (QSRepositoryCpp *repo, const QVariant &qsValue);
+    static bool         writeProperty   (QSRepositoryCpp *repo, QSObjectCpp *qsObject,
+                                         const QString &propName, const QVariant &value);
+
+    /* Attributes
+     * ****************************************************************************************/
+    QString             m_name;
+    QString             m_rootId;
+    QVariantMap         m_objects;
+    QList<Event>        m_events;
+
+    Factory             m_factory;
+};
+
+#endif // QSMUTATIONREPLAYER_H
@@ -29,6 +29,12 @@ class QSObjectCpp : public QObject
     Q_PROPERTY(QString              qsType            READ getType                               CONSTANT)
     QML_ELEMENT
 
+    friend class QSGarbageCollectorCpp;
+    friend class QSObjectListCpp;
+    friend class QSObjectPoolCpp;
+    friend class QSRepositoryCpp;
+    friend class QSUndoHistoryCpp;
+
 public:
     /* Public Constructors & Destructor
      * ****************************************************************************************/
@@ -0,0 +1,120 @@
+#ifndef QSOBJECTLISTCPP_H
+#define QSOBJECTLISTCPP_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <qqml.h>
+
+class QSObjectCpp;
+
+/*! ***********************************************************************************************
+ * QSObjectListCpp is an ordered container for the child QSObjects of an owner QSObject (e.g., the
+ * nodes of a scene). It replaces the JS map containers handled by QSObject.qml's addElement(),
+ * removeElement() and setElements().
+ *
+ * Like addElement(), added elements are assigned to the repo of the owner and parented to it, and
+ * removed elements are detached from both. The list is a QAbstractListModel that emits fine-grained
+ * insert/remove/move signals, so views only update the affected rows (setElements() falls back to a
+ * model reset for larger changes). Changes are reported to the
+ * repo as change of the owner, and the list is serialized as list of references (qqs:/UUID).
+ *
+ * Usage (QML): property QSObjectListCpp nodes: QSObjectListCpp {}
+ *
+ * \note    The owner defaults to the parent, i.e., the object the list is declared in
+ * \note    Insertions, removals and moves are undoable as change of the owner's list property (see
+ *          QSUndoHistoryCpp)
+ * ************************************************************************************************/
+class QSObjectListCpp : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(QSObjectCpp*     owner           READ getOwner       WRITE setOwner  NOTIFY ownerChanged)
+    Q_PROPERTY(int              count           READ count                          NOTIFY countChanged)
+    Q_PROPERTY(QVariantList     elements        READ getElements    WRITE setElements NOTIFY elementsChanged)
+    Q_PROPERTY(bool             _qsIsObjectList READ isObjectList                   CONSTANT)
+    QML_ELEMENT
+
+public:
+    /* Public Types
+     * ****************************************************************************************/
+    enum Roles {
+        QSObjectRole = Qt::UserRole + 1,
+        QSUuidRole
+    };
+
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit QSObjectListCpp(QObject *parent = nullptr);
+
+    /* Public Getters & Setters
+     * ****************************************************************************************/
+    QSObjectCpp        *getOwner        () const;
+    int                 count           () const;
+    QVariantList        getElements     () const;
+    bool                isObjectList    () const;
+
+    void                setOwner        (QSObjectCpp *owner);
+
+    /* Public Functions (QAbstractListModel)
+     * ****************************************************************************************/
+    int                     rowCount    (const QModelIndex &parent = QModelIndex()) const override;
+    QVariant                data        (const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray>  roleNames   () const override;
+
+    /* Public Functions
+     * ****************************************************************************************/
+    const QList<QSObjectCpp*> &elements () const;
+    bool                removeReference (const QObject *element);
+
+public slots:
+    /* Public Slots
+     * ****************************************************************************************/
+    bool                append          (QSObjectCpp *element);
+    bool                insert          (int index, QSObjectCpp *element);
+    bool                remove          (QSObjectCpp *element);
+    bool                removeAt        (int index);
+    bool                move            (int from, int to);
+    void                clear           ();
+    void                setElements     (const QVariantList &elements);
+
+    bool                contains        (QSObjectCpp *element) const;
+    int                 indexOf         (QSObjectCpp *element) const;
+    QSObjectCpp        *get             (int index) const;
+    QSObjectCpp        *getByUuid       (const QString &uuidStr) const;
+
+signals:
+    /* Signals
+     * ****************************************************************************************/
+    void                ownerChanged();
+    void                countChanged();
+    void                elementsChanged();
+
+private slots:
+    /* Private Slots
+     * ****************************************************************************************/
+    void                onElementDestroyed  (QObject *object);
+    void                onElementUuidChanged();
+    void                onOwnerDestroyed    (QObject *owner);
+
+private:
+    /* Private Functions
+     * ****************************************************************************************/
+    QSObjectCpp        *ownerObject     () const;
+    void                attach          (QSObjectCpp *element);
+    void                detach          (QSObjectCpp *element, bool release);
+    bool                takeAt          (int index, bool release);
+    void                notifyChanged   (int oldCount);
+
+    /* Attributes
+     * ****************************************************************************************/
+    QPointer<QSObjectCpp>           m_owner;
+
+    //! Elements in order, and by UUID for constant time lookup (both ways, as destroyed elements
+    //! cannot be asked for their UUID)
+    QList<QSObjectCpp*>             m_elements;
+    QHash<QString, QSObjectCpp*>    m_elementsByUuid;
+    QHash<const QObject*, QString>  m_uuidsByElement;
+};
+
+#endif // QSOBJECTLISTCPP_H
@@ -0,0 +1,108 @@
+#ifndef QSOBJECTPOOLCPP_H
+#define QSOBJECTPOOLCPP_H
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QVariant>
+#include <qqml.h>
+
+class QSObjectCpp;
+class QSRepositoryCpp;
+
+/*! ***********************************************************************************************
+ * QSObjectPoolCpp keeps QSObjects that were removed from a QSRepositoryCpp for reuse, so reloading
+ * a repository does not have to instantiate every QML object again.
+ *
+ * Recycled objects are unregistered and parked per qsType. The loader acquires parked objects
+ * before creating new ones, and then writes the loaded properties just like for new objects. The
+ * serialized properties of each qsType are captured from its first freshly created object (see
+ * captureDefaults()), types without captured defaults are never pooled.
+ *
+ * Plain values are never written when recycling, so bindings of an object are kept until the
+ * loader overwrites them. Objects of QML types are only reused if the loaded properties cover all
+ * serialized properties (their other defaults may be bindings). C++ types are reset to the
+ * captured defaults instead. Objects that are still referenced, or that the undo history may add
+ * again, are never recycled.
+ *
+ * The pool is disabled by default.
+ *
+ * \note    Objects are reused as is: Component.onCompleted is not run again, and non-serialized
+ *          state (e.g., '_' properties, sub-objects owned by an object) is not reset
+ * ************************************************************************************************/
+class QSObjectPoolCpp : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool     enabled     READ isEnabled      WRITE setEnabled    NOTIFY enabledChanged)
+    Q_PROPERTY(int      maxPerType  READ getMaxPerType  WRITE setMaxPerType NOTIFY limitsChanged)
+    Q_PROPERTY(int      maxTotal    READ getMaxTotal    WRITE setMaxTotal   NOTIFY limitsChanged)
+    Q_PROPERTY(int      size        READ size                               NOTIFY sizeChanged)
+    Q_PROPERTY(int      hits        READ getHits                            NOTIFY sizeChanged)
+    Q_PROPERTY(int      misses      READ getMisses                          NOTIFY sizeChanged)
+    QML_ELEMENT
+    QML_UNCREATABLE("QSObjectPoolCpp is provided by QSRepositoryCpp")
+
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit QSObjectPoolCpp(QSRepositoryCpp *repo);
+
+    /* Public Getters & Setters
+     * ****************************************************************************************/
+    bool                isEnabled       () const;
+    int                 getMaxPerType   () const;
+    int                 getMaxTotal     () const;
+    int                 size            () const;
+    int                 getHits         () const;
+    int                 getMisses       () const;
+
+    void                setEnabled      (bool enabled);
+    void                setMaxPerType   (int maxPerType);
+    void                setMaxTotal     (int maxTotal);
+
+public slots:
+    /* Public Slots
+     * ****************************************************************************************/
+    void                captureDefaults (QSObjectCpp *qsObject);
+
+    bool                recycle         (QSObjectCpp *qsObject);
+    QSObjectCpp        *acquire         (const QString &qsType, const QVariantMap &qsProps = {});
+
+    int                 countByType     (const QString &qsType) const;
+    void                clear           ();
+
+signals:
+    /* Signals
+     * ****************************************************************************************/
+    void                enabledChanged();
+    void                limitsChanged();
+    void                sizeChanged();
+
+private:
+    /* Private Functions
+     * ****************************************************************************************/
+    void                trimToLimits    ();
+    bool                resetMissing    (QSObjectCpp *qsObject, const QVariantMap &qsProps) const;
+
+    static bool         isNativeType    (const QMetaObject *metaObject);
+
+    /* Attributes
+     * ****************************************************************************************/
+    QSRepositoryCpp    *m_repo;
+
+    bool                m_enabled;
+    int                 m_maxPerType;
+    int                 m_maxTotal;
+    int                 m_size;
+    int                 m_hits;
+    int                 m_misses;
+
+    //! Default (plain) values of the serialized properties by qsType and property index
+    QHash<QString, QHash<int, QVariant>>                m_defaults;
+
+    //! Parked objects by qsType (most recently parked last)
+    QHash<QString, QList<QPointer<QSObjectCpp>>>        m_parked;
+};
+
+#endif // QSOBJECTPOOLCPP_H
@@ -2,14 +2,25 @@
 #define QSSREPOSITORYCPP_H
 
 #include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QUrl>
 #include <QUuid>
 #include <qqml.h>
 
+#include "QSGarbageCollectorCpp.h"
+#include "QSIndexedFileCpp.h"
+#include "QSMutationRecorderCpp.h"
 #include "QSObjectCpp.h"
+#include "QSObjectPoolCpp.h"
+#include "QSRepositorySnapshot.h"
+#include "QSUndoHistoryCpp.h"
 
 /*! ***********************************************************************************************
  * QSRepositoryCpp is the container that stores and manages QSObjects. It can be de/serialized
  * from/to the disk, and will enable enable other mechanisms in the future (e.g., RPCs, etc.).
+ *
+ * \note    Objects of forwarded repos are not part of _qsObjects, use getObject()/findObject()
  * ************************************************************************************************/
 
 class QSRepositoryCpp : public QSObjectCpp
@@ -20,34 +31,132 @@ class QSRepositoryCpp : public QSObjectCpp
      * ****************************************************************************************/
     Q_PROPERTY(QSObjectCpp   *qsRootObject   MEMBER  m_rootObject        NOTIFY rootObjectChanged)
 
-    Q_PROPERTY(QVariantList  _addedObjects   MEMBER  m_addedObjects      NOTIFY addedObjectsChanged)
-    Q_PROPERTY(QVariantList  _deletedObjects MEMBER  m_deletedObjects    NOTIFY deletedObjectsChanged)
+    Q_PROPERTY(QVariantList  _addedObjects   READ    getAddedObjects     WRITE setAddedObjects   NOTIFY addedObjectsChanged)
+    Q_PROPERTY(QVariantList  _deletedObjects READ    getDeletedObjects   WRITE setDeletedObjects NOTIFY deletedObjectsChanged)
     Q_PROPERTY(QVariantList  _forwardedRepos MEMBER  m_forwardedRepos    NOTIFY forwardedReposChanged)
-    Q_PROPERTY(QVariantList  _updatedObjects MEMBER  m_updatedObjects    NOTIFY updatedObjectsChanged)
+    Q_PROPERTY(QVariantList  _updatedObjects READ    getUpdatedObjects   WRITE setUpdatedObjects NOTIFY updatedObjectsChanged)
 
     Q_PROPERTY(QVariantMap   _qsObjects      MEMBER  m_objects           NOTIFY objectsChanged)
 
     Q_PROPERTY(bool          _isLoading      MEMBER  m_isLoading         NOTIFY isLoadingChanged)
+    Q_PROPERTY(bool          _isBatching     READ    isBatching          NOTIFY isBatchingChanged)
 
     Q_PROPERTY(QString       name            MEMBER  m_name              NOTIFY nameChanged)
 
+    Q_PROPERTY(QSUndoHistoryCpp *_undoHistory READ getUndoHistory        CONSTANT)
+    Q_PROPERTY(QSGarbageCollectorCpp *_collector READ getCollector       CONSTANT)
+    Q_PROPERTY(QSObjectPoolCpp  *_objectPool READ getObjectPool          CONSTANT)
+    Q_PROPERTY(QSMutationRecorderCpp *_recorder READ getRecorder         CONSTANT)
+
     QML_ELEMENT
 
+    friend class QSGarbageCollectorCpp;
+    friend class QSMutationRecorderCpp;
+    friend class QSMutationReplayer;
+    friend class QSObjectPoolCpp;
+    friend class QSUndoHistoryCpp;
+
 public:
+    /* Public Types
+     * ****************************************************************************************/
+    //! What happens to references to an object when it is deleted (see deleteObject())
+    enum DeletePolicy {
+        KeepReferences,     //!< References are left dangling
+        NullReferences,     //!< References are removed from all referrers
+        CascadeReferences   //!< As NullReferences, and unreferenced targets are deleted as well
+    };
+    Q_ENUM(DeletePolicy)
+
     /* Public Constructors & Destructor
      * ****************************************************************************************/
     explicit QSRepositoryCpp(QObject *parent = nullptr);
     virtual ~QSRepositoryCpp();
 
+    /* Public Functions
+     * ****************************************************************************************/
+    QSRepositorySnapshot snapshot();
+    void                 notifyObjectChanged(QSObjectCpp *qsObject, const QString &propName = QString());
+
+    /* Public Getters
+     * ****************************************************************************************/
+    QVariantList getAddedObjects  () const;
+    QVariantList getDeletedObjects() const;
+    QVariantList getUpdatedObjects() const;
+    bool         isBatching  () const;
+    QSObjectCpp *getObject   (const QString &uuidStr) const;
+    QSUndoHistoryCpp *getUndoHistory() const;
+    QSGarbageCollectorCpp *getCollector() const;
+    QSObjectPoolCpp  *getObjectPool() const;
+    QSMutationRecorderCpp *getRecorder() const;
+
+    /* Public Setters
+     * ****************************************************************************************/
+    void         setAddedObjects  (const QVariantList &addedObjects);
+    void         setDeletedObjects(const QVariantList &deletedObjects);
+    void         setUpdatedObjects(const QVariantList &updatedObjects);
+
 public slots:
     /* Public Slots
      * ****************************************************************************************/
     bool forwardRepo     (QSRepositoryCpp *qsRepository);
     bool unforwardRepo   (QSRepositoryCpp *qsRepository);
 
+    QVariant findObject  (const QString &uuidStr) const;
+
     bool registerObject  (QSObjectCpp *qsObject);
     bool unregisterObject(QSObjectCpp *qsObject);
 
+    bool beginBatch      ();
+    bool commitBatch     ();
+    bool rollbackBatch   ();
+
+    // Indexed files & on-demand loading
+    bool        isIndexedFile       (const QString &fileName) const;
+    bool        isIndexedFile       (const QUrl &fileUrl) const;
+    bool        openIndexedFile     (const QString &fileName);
+    bool        openIndexedFile     (const QUrl &fileUrl);
+    void        closeIndexedFile    ();
+    bool        isIndexedFileOpen   () const;
+    bool        writeIndexedFile    (const QString &fileName, const QVariantMap &repoDump);
+    bool        writeIndexedFile    (const QUrl &fileUrl, const QVariantMap &repoDump);
+
+    QVariantMap getIndexedFileMeta  () const;
+    bool        isIndexedObject     (const QString &uuidStr) const;
+    bool        isPagedOut          (const QString &uuidStr) const;
+    QStringList getPagedOutIds      () const;
+    QVariantMap readIndexedObjects  (const QStringList &uuidStrs, bool withReferences = true);
+    QStringList evictObjects        (const QStringList &uuidStrs);
+
+    // Secondary indices
+    QStringList  getObjectTypes         () const;
+    int          countObjectsByType     (const QString &qsType) const;
+    QVariantList findObjectsByType      (const QString &qsType) const;
+
+    bool         addPropertyIndex       (const QString &propName);
+    bool         removePropertyIndex    (const QString &propName);
+    QStringList  getPropertyIndices     () const;
+    QVariantList findObjectsByProperty  (const QString &propName, const QVariant &value) const;
+
+    // Reverse references
+    QStringList  getReferrers           (const QString &uuidStr) const;
+    QStringList  getReferences          (const QString &uuidStr) const;
+    bool         isReferenced           (const QString &uuidStr) const;
+    void         updateReferences       (const QStringList &uuidStrs);
+    QStringList  deleteObject           (const QString &uuidStr,
+                                         DeletePolicy policy = NullReferences);
+
+    // Content hashes
+    QString      getContentHash         (const QString &uuidStr);
+    bool         isObjectChanged        (const QString &uuidStr);
+    QStringList  getChangedObjectIds    ();
+    void         markPersisted          (const QStringList &uuidStrs = QStringList());
+    QString      getRepoDigest          ();
+    QStringList  getDigestBuckets       ();
+
+    // Diagnostics
+    QVariantMap  getMemoryReport        ();
+    QString      getMemoryReportJson    ();
+
 signals:
     /* Signals
      * ****************************************************************************************/
@@ -56,9 +165,15 @@ signals:
     void forwardedReposChanged();
     void updatedObjectsChanged();
 
+    // Single changes are signalled per object, changes of several objects at once (batches, bulk
+    // deletions, forwarded changes) by a single objectsAdded()/objectsDeleted() only
     void objectAdded     (QSObjectCpp *qsObject);
     void objectDeleted   (const QString &uuidStr);
+    void objectsAdded    (const QVariantList &qsObjects);
+    void objectsDeleted  (const QStringList &uuidStrs);
+    void objectsEvicted  (const QStringList &uuidStrs);
 
+    void isBatchingChanged();
     void isLoadingChanged();
     void nameChanged();
     void objectsChanged();
@@ -76,7 +191,9 @@ protected slots:
                       bool force = false);
     bool clearObjects();
     bool delObject   (const QString &uuidStr, bool suppressSignal = false);
+    bool delObjects  (const QStringList &uuidStrs);
 
+    void flushForwardedChanges();
     void onIsAvailableChanged();
     void onObjectChanged();
 
@@ -85,13 +202,75 @@ private:
      * ****************************************************************************************/
     void observeObject  (QSObjectCpp *qsObject);
     void unobserveObject(QSObjectCpp *qsObject);
+    int  countObservedSignals(QSObjectCpp *qsObject) const;
+
+    static bool isObservedSignal(const QMetaMethod &metaMethod);
+
+    void recordBatchAdd (const QString &uuidStr, QSObjectCpp *qsObject);
+    void recordBatchDel (const QString &uuidStr, QSObjectCpp *qsObject);
+    void resetBatch     ();
+
+    void emitObjectsAdded   (const QVariantList &qsObjects);
+    void emitObjectsDeleted (const QStringList &uuidStrs);
+
+    bool isForwarding   (const QSRepositoryCpp *qsRepository) const;
+    void recordForwardedAdd(const QString &uuidStr, QSObjectCpp *qsObject);
+    void recordForwardedDel(const QString &uuidStr);
+    void scheduleForwardedFlush();
+
+    void handleObjectChanged(QObject *object, int propertyIndex);
+
+    void markDirty          (const QString &uuidStr);
+    void updateContentHashes();
+    void updateDigest       ();
+
+    QVariantMap getStorageProps(QSObjectCpp *qsObject);
+
+    static int digestBucket (const QString &uuidStr);
+
+    void indexObject    (const QString &uuidStr, QSObjectCpp *qsObject);
+    void unindexObject  (const QString &uuidStr, QSObjectCpp *qsObject);
+    void indexProperty  (const QString &propName, const QString &uuidStr, QSObjectCpp *qsObject);
+
+    void indexReferences    (const QString &uuidStr, QSObjectCpp *qsObject,
+                             const QString &propName = QString());
+    void unindexReferences  (const QString &uuidStr);
+    void setReferences      (const QString &uuidStr, const QString &propName,
+                             const QStringList &targetIds);
+
+    /* Private Types
+     * ****************************************************************************************/
+    //! Pending changes (exposed to QML as list) with constant time lookup and removal. Removed
+    //! entries are left as tombstones until the list is read or mostly consists of tombstones.
+    template <typename Key>
+    struct PendingList {
+        bool            append  (const Key &key, const QVariant &item);
+        bool            remove  (const Key &key);
+        void            assign  (const QVariantList &newItems);
+        QVariantList    values  () const;
+
+        static Key      keyOf   (const QVariant &item);
+
+        mutable QVariantList            items;
+        mutable QHash<Key, qsizetype>   indices;
+        mutable qsizetype               tombstones = 0;
+
+    private:
+        void            compact () const;
+    };
+
+    //! Value index of a single property (values are stored as compact JSON)
+    struct PropertyIndex {
+        QHash<QByteArray, QSet<QString>>    uuidsByValue;
+        QHash<QString, QByteArray>          valueByUuid;
+    };
 
     /* Attributes
      * ****************************************************************************************/
-    QVariantList        m_addedObjects;
-    QVariantList        m_deletedObjects;
-    QVariantList        m_forwardedRepos;
-    QVariantList        m_updatedObjects;
+    PendingList<const QObject*> m_addedObjects;
+    PendingList<QString>        m_deletedObjects;
+    QVariantList                m_forwardedRepos;
+    PendingList<const QObject*> m_updatedObjects;
 
     bool                m_isLoading;
 
@@ -100,6 +279,53 @@ private:
     QVariantMap         m_objects;
 
     QSObjectCpp        *m_rootObject;
+
+    quint64                         m_revision;
+    QSRepositorySnapshot::ObjectMap m_snapshotObjects;
+    QSet<QString>                   m_snapshotDirtyIds;
+
+    // Batch administration (net changes since beginBatch(), used for commit and rollback)
+    int                                     m_batchDepth;
+    QHash<QString, QPointer<QSObjectCpp>>   m_batchAddedObjects;
+    QHash<QString, QPointer<QSObjectCpp>>   m_batchDeletedObjects;
+    PendingList<const QObject*>             m_batchAddedBackup;
+    PendingList<QString>                    m_batchDeletedBackup;
+    bool                                    m_batchUpdated;
+
+    // Net changes of forwarded repos, relayed in batches
+    QHash<QString, QPointer<QSObjectCpp>>   m_forwardedAddedPending;
+    QSet<QString>                           m_forwardedDeletedPending;
+    bool                                    m_forwardedFlushScheduled;
+
+    QSUndoHistoryCpp       *m_undoHistory;
+    QSGarbageCollectorCpp  *m_collector;
+    QSObjectPoolCpp        *m_objectPool;
+    QSMutationRecorderCpp  *m_recorder;
+
+    // Indexed file of lazily loaded repos, and the objects that were not loaded (yet)
+    QSIndexedFileCpp    m_indexedFile;
+    QSet<QString>       m_pagedOutIds;
+
+    // Secondary indices: objects by qsType, and (opt-in) by property value
+    QHash<QString, QHash<QString, QSObjectCpp*>>    m_typeIndex;
+    QHash<QString, PropertyIndex>                   m_propertyIndices;
+
+    // Reference index: targets by referrer and property, referrers by target (with count)
+    QHash<QString, QHash<QString, QStringList>>     m_references;
+    QHash<QString, QHash<QString, int>>             m_referrers;
+
+    // Content hashes by digest bucket (see digestBucket()), and as last persisted
+    QList<QHash<QString, quint64>>  m_contentHashes;
+    QSet<QString>                   m_hashDirtyIds;
+    QHash<QString, quint64>         m_persistedHashes;
+
+    // Merkle-style digest: a hash per bucket, and over all buckets
+    QList<quint64>                  m_digestBuckets;
+    QSet<int>                       m_digestDirtyBuckets;
+    quint64                         m_repoDigest;
+
+    //! Index of the QML storageProps() function (-1 if none, -2 if not resolved yet)
+    int                             m_storagePropsMethod;
 };
 
 #endif // QSREPOSITORYCPP_H
@@ -0,0 +1,77 @@
+#ifndef QSREPOSITORYFILE_H
+#define QSREPOSITORYFILE_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QStringList>
+#include <QVariantMap>
+
+/*! ***********************************************************************************************
+ * QSRepositoryFile reads, checks and writes stored repositories (JSON or indexed files) without
+ * instantiating any object, so files can be processed without a QML engine (e.g., by qqstool).
+ *
+ * The file is held as the stored property maps of all objects plus the non-object entries (root,
+ * version, application). References between objects are the qqs:/UUID strings in the maps.
+ *
+ * \note    Instances are not shared, but separate instances can be used from different threads
+ * ************************************************************************************************/
+class QSRepositoryFile
+{
+public:
+    /* Public Types
+     * ****************************************************************************************/
+    enum Format { Json, Indexed };
+
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    QSRepositoryFile();
+
+    /* Public Functions
+     * ****************************************************************************************/
+    bool                read            (const QString &fileName, QString *errorString = nullptr);
+    bool                write           (const QString &fileName, Format format) const;
+
+    Format              format          () const;
+    QVariantMap         meta            () const;
+    QString             rootId          () const;
+    QStringList         objectIds       () const;
+    QJsonObject         object          (const QString &uuidStr) const;
+
+    bool                checkHeader     (const QString &applicationName, const QString &version,
+                                         const QString &minimumVersion, QStringList &errors) const;
+
+    QStringList         findUnreachable () const;
+    QStringList         findDangling    () const;
+    QStringList         compact         ();
+    QVariantMap         statistics      () const;
+
+    /* Public Static Functions
+     * ****************************************************************************************/
+    static Format       detectFormat            (const QString &fileName);
+    static int          versionNumber           (const QString &version);
+    static bool         isSupportedVersion      (const QString &savedVersion,
+                                                 const QString &minimumVersion);
+    static bool         isApplicationVersion    (const QString &savedVersion,
+                                                 const QString &version);
+
+    /* Public Static Attributes
+     * ****************************************************************************************/
+    //! Keys of the non-object entries -- mirrors QSRepository.qml
+    static const QString rootKey;
+    static const QString versionKey;
+    static const QString applicationKey;
+
+private:
+    /* Private Functions
+     * ****************************************************************************************/
+    QStringList         referencedIds   (const QString &uuidStr) const;
+
+    /* Attributes
+     * ****************************************************************************************/
+    Format                          m_format;
+    qint64                          m_fileSize;
+    QVariantMap                     m_meta;
+    QHash<QString, QJsonObject>     m_objects;
+};
+
+#endif // QSREPOSITORYFILE_H
@@ -0,0 +1,62 @@
+#ifndef QSREPOSITORYSNAPSHOT_H
+#define QSREPOSITORYSNAPSHOT_H
+
+#include <QHash>
+#include <QMetaType>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVariantMap>
+
+/*! ***********************************************************************************************
+ * QSRepositorySnapshot is an immutable, cheaply-copyable view of a QSRepositoryCpp at a given
+ * revision. Each object is stored as its serialized property map (see QSSerializerCpp), so no
+ * live QObject is touched while reading.
+ *
+ * Successive snapshots of the same repo share the property maps of all objects that did not
+ * change in between -- only modified objects are re-serialized.
+ *
+ * \note    Snapshots can be copied to and read from any thread.
+ * ************************************************************************************************/
+class QSRepositorySnapshot
+{
+public:
+    using ObjectData = QSharedPointer<const QVariantMap>;
+    using ObjectMap  = QHash<QString, ObjectData>;
+
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    QSRepositorySnapshot();
+    QSRepositorySnapshot(const QString &repoId, const QString &rootId,
+                         const ObjectMap &objects, quint64 revision);
+
+    /* Public Getters
+     * ****************************************************************************************/
+    bool                isNull      () const;
+
+    QString             getRepoId   () const;
+    QString             getRootId   () const;
+    quint64             getRevision () const;
+
+    qsizetype           size        () const;
+    bool                contains    (const QString &uuidStr) const;
+    QStringList         objectIds   () const;
+
+    QVariantMap         object      (const QString &uuidStr) const;
+    ObjectData          objectData  (const QString &uuidStr) const;
+
+    /* Public Functions
+     * ****************************************************************************************/
+    QVariantMap         dump        (const QString &rootKey = QStringLiteral("root")) const;
+
+private:
+    /* Attributes
+     * ****************************************************************************************/
+    QString             m_repoId;
+    QString             m_rootId;
+    ObjectMap           m_objects;
+    quint64             m_revision;
+};
+
+Q_DECLARE_METATYPE(QSRepositorySnapshot)
+
+#endif // QSREPOSITORYSNAPSHOT_H
@@ -0,0 +1,291 @@
+#ifndef QSSCHEMA_H
+#define QSSCHEMA_H
+
+#include "QSObjectCpp.h"
+#include "QSSerializerCpp.h"
+#include "QSValueCodecs.h"
+
+#include <QDebug>
+#include <QMetaEnum>
+#include <QVarLengthArray>
+#include <QVariantMap>
+
+#include <tuple>
+#include <type_traits>
+
+/*! ***********************************************************************************************
+ * Compile-time serialization schemas for QSObjectCpp subclasses defined in C++ (opt-in).
+ *
+ * A schema lists the serialized members of a type with their property name and change signal:
+ *
+ *      class MyNode : public QSObjectCpp {
+ *          Q_OBJECT
+ *          Q_PROPERTY(double  x     MEMBER m_x     NOTIFY xChanged)
+ *          Q_PROPERTY(QString title MEMBER m_title NOTIFY titleChanged)
+ *          ...
+ *      };
+ *
+ *      QS_SCHEMA(MyNode,
+ *          QS_FIELD(x,     m_x,     xChanged),
+ *          QS_FIELD(title, m_title, titleChanged))
+ *
+ *      QSSchema::registerType<MyNode>();   // once, e.g., in main()
+ *
+ * Registered types are serialized (QSSerializerCpp::getQSProps(), QSSerializer.qml), applied when
+ * loading (QSSerializer.fromQSUrlProps()) and observed by the repo through the generated code,
+ * i.e., members are read and written directly and signals are connected without QMetaObject
+ * lookups. Schemas do not provide an unboxed write path: values are still boxed in QVariants and
+ * stored in (plain) QVariantMaps. The maps are the same as those of the generic path, so files are
+ * compatible.
+ *
+ * \note    Only objects whose meta object is the type's static one use the schema, e.g., QML types
+ *          deriving from a registered type (with properties of their own) use the generic path
+ * \note    The schema must list all serialized properties of the type (missing ones are reported
+ *          by registerType()); declare 'friend struct QSSchemaTraits<Type>;' for private members
+ * \note    Change signals must not have arguments, enum members must be declared with Q_ENUM
+ * \note    References (QSObjectCpp pointers) are stored as URL and resolved by the generic path
+ * ************************************************************************************************/
+template <typename T>
+struct QSSchemaTraits
+{
+    static constexpr bool isDefined = false;
+};
+
+//! Defines the schema of Type, fields are listed with QS_FIELD()
+#define QS_SCHEMA(Type, ...)                                                                        \
+    template <>                                                                                     \
+    struct QSSchemaTraits<Type>                                                                     \
+    {                                                                                               \
+        using SchemaType = Type;                                                                    \
+        static constexpr bool isDefined = true;                                                     \
+        static auto fields() { return std::make_tuple(__VA_ARGS__); }                               \
+    };
+
+//! Field of a schema: property name, member and change signal
+#define QS_FIELD(propName, member, notify)                                                          \
+    QSSchema::field<SchemaType>(#propName, &SchemaType::member, &SchemaType::notify)
+
+/*! ***********************************************************************************************
+ * QSSchemaRegistry holds the generated functions of all registered types (by static meta object).
+ * ************************************************************************************************/
+class QSSchemaRegistry
+{
+public:
+    /* Public Types
+     * ****************************************************************************************/
+    using ChangedCallback = void (*)(QObject *receiver, QObject *object, int propertyIndex);
+
+    struct Entry
+    {
+        QVariantMap (*toQSProps)    (const QObject *object) = nullptr;
+        QVariantMap (*applyQSProps) (QObject *object, const QVariantMap &qsProps) = nullptr;
+        void        (*observe)      (QObject *object, QObject *receiver, ChangedCallback onChanged) = nullptr;
+        int           signalCount = 0;      //!< Number of signals connected by observe()
+
+        bool isValid() const { return toQSProps != nullptr; }
+    };
+
+    /* Public Static Functions
+     * ****************************************************************************************/
+    static void         registerEntry   (const QMetaObject *metaObject, const Entry &entry);
+    static Entry        find            (const QMetaObject *metaObject);
+};
+
+namespace QSSchema {
+
+/* Fields
+ * ************************************************************************************************/
+template <typename Class, typename Member>
+struct Field
+{
+    const char     *name;
+    Member Class::*member;
+    void (Class::*notify)();
+};
+
+//! Creates a field of Class (members and signals can be declared in base classes)
+template <typename Class, typename Member, typename MemberClass, typename NotifyClass>
+Field<Class, Member> field(const char *name, Member MemberClass::*member,
+                           void (NotifyClass::*notify)())
+{
+    return { name, member, notify };
+}
+
+//! Calls f(field, index) for all fields of the schema of T
+template <typename T, typename F>
+void forEachField(F &&f)
+{
+    static const auto fields = QSSchemaTraits<T>::fields();
+
+    std::apply([&f](const auto &...field) {
+        int index = 0;
+        (f(field, index++), ...);
+    }, fields);
+}
+
+/* Value Conversions
+ * ************************************************************************************************/
+template <typename V>
+constexpr bool isPrimitive = std::is_same_v<V, bool>    || std::is_same_v<V, int>
+                          || std::is_same_v<V, qint64>  || std::is_same_v<V, double>
+                          || std::is_same_v<V, float>   || std::is_same_v<V, QString>;
+
+template <typename V>
+constexpr bool isReference = std::is_pointer_v<V>
+                          && std::is_base_of_v<QSObjectCpp, std::remove_pointer_t<V>>;
+
+//! Returns the stored value -- same as QSSerializerCpp::getQSProp() of the property value
+template <typename V>
+QVariant toQSValue(const V &value)
+{
+    if constexpr (isPrimitive<V>) {
+        return QVariant(value);
+    } else if constexpr (isReference<V>) {
+        return value != nullptr ? QVariant(QSSerializerCpp::getQSUrl(value)) : QVariant();
+    } else if constexpr (std::is_enum_v<V>) {
+        return QSValueCodecs::encodeEnum(QMetaEnum::fromType<V>(), int(value));
+    } else {
+        return QSSerializerCpp::getQSProp(QVariant::fromValue(value));
+    }
+}
+
+//! Converts a stored value, returns false if it must be handled by the generic path (references)
+template <typename V>
+bool fromQSValue(const QVariant &qsValue, V &value)
+{
+    if constexpr (isReference<V>) {
+        return false;
+    } else if constexpr (isPrimitive<V>) {
+        value = qsValue.value<V>();
+        return true;
+    } else if constexpr (std::is_enum_v<V>) {
+        const QVariant decoded = qsValue.typeId() == QMetaType::QVariantMap
+                               ? QSValueCodecs::decode(qsValue.toMap())
+                               : qsValue;
+        value = static_cast<V>(decoded.toInt());
+        return true;
+    } else {
+        const QVariant decoded = qsValue.typeId() == QMetaType::QVariantMap
+                                     && QSValueCodecs::isEncoded(qsValue.toMap())
+                               ? QSValueCodecs::decode(qsValue.toMap())
+                               : qsValue;
+        if (!decoded.canConvert<V>()) { return false; }
+
+        value = decoded.value<V>();
+        return true;
+    }
+}
+
+/* Generated Functions
+ * ************************************************************************************************/
+//! Returns the stored properties of object -- same as QSSerializerCpp::getQSProps()
+template <typename T>
+QVariantMap toQSProps(const T &object)
+{
+    QVariantMap qsProps;
+    qsProps.insert(QStringLiteral("qsType"), QString::fromLatin1(T::staticMetaObject.className()));
+    qsProps.insert(QStringLiteral("qsIsAvailable"), object.getIsAvailable());
+
+    forEachField<T>([&](const auto &field, int) {
+        qsProps.insert(QLatin1String(field.name), toQSValue(object.*(field.member)));
+    });
+
+    return qsProps;
+}
+
+//! Writes all fields in qsProps (emitting the signals of changed fields), and returns the
+//! properties left for the generic path
+template <typename T>
+QVariantMap applyQSProps(T &object, const QVariantMap &qsProps)
+{
+    QVariantMap remainingProps = qsProps;
+    remainingProps.remove(QStringLiteral("qsType"));
+
+    forEachField<T>([&](const auto &field, int) {
+        const auto it = remainingProps.constFind(QLatin1String(field.name));
+        if (it == remainingProps.constEnd()) { return; }
+
+        auto value = object.*(field.member);
+        if (!fromQSValue(it.value(), value)) { return; }
+
+        remainingProps.erase(it);
+
+        if (!(value == object.*(field.member))) {
+            object.*(field.member) = std::move(value);
+            emit (object.*(field.notify))();
+        }
+    });
+
+    return remainingProps;
+}
+
+//! Connects the change signals of all fields (and availability) to onChanged
+template <typename T>
+void observe(T &object, QObject *receiver, QSSchemaRegistry::ChangedCallback onChanged)
+{
+    // Property indices are looked up once per type
+    static const QVarLengthArray<int, 16> propertyIndices = [] {
+        QVarLengthArray<int, 16> indices;
+        forEachField<T>([&indices](const auto &field, int) {
+            indices.append(T::staticMetaObject.indexOfProperty(field.name));
+        });
+        return indices;
+    }();
+    static const int isAvailableIndex = T::staticMetaObject.indexOfProperty("qsIsAvailable");
+
+    QObject *objectPtr = &object;
+
+    QObject::connect(&object, &QSObjectCpp::isAvailableChanged, receiver,
+                     [receiver, objectPtr, onChanged]() {
+                         onChanged(receiver, objectPtr, isAvailableIndex);
+                     });
+
+    forEachField<T>([&](const auto &field, int index) {
+        const int propertyIndex = propertyIndices.at(index);
+
+        QObject::connect(&object, field.notify, receiver,
+                         [receiver, objectPtr, onChanged, propertyIndex]() {
+                             onChanged(receiver, objectPtr, propertyIndex);
+                         });
+    });
+}
+
+//! Returns the serialized properties of T that are not part of its schema
+QStringList missingProperties(const QMetaObject *metaObject, const QStringList &fieldNames);
+
+//! Registers the schema of T, so all serialization of T uses the generated functions
+template <typename T>
+void registerType()
+{
+    static_assert(QSSchemaTraits<T>::isDefined, "No schema defined for T, see QS_SCHEMA()");
+    static_assert(std::is_base_of_v<QSObjectCpp, T>, "Schemas are only supported for QSObjects");
+
+    QStringList fieldNames;
+    forEachField<T>([&fieldNames](const auto &field, int) {
+        fieldNames.append(QLatin1String(field.name));
+    });
+
+    const QStringList missingPropNames = missingProperties(&T::staticMetaObject, fieldNames);
+    if (!missingPropNames.isEmpty()) {
+        qWarning() << "[QSSchema]" << T::staticMetaObject.className()
+                   << "does not list properties" << missingPropNames;
+    }
+
+    QSSchemaRegistry::Entry entry;
+    entry.toQSProps = [](const QObject *object) {
+        return toQSProps(*static_cast<const T*>(object));
+    };
+    entry.applyQSProps = [](QObject *object, const QVariantMap &qsProps) {
+        return applyQSProps(*static_cast<T*>(object), qsProps);
+    };
+    entry.observe = [](QObject *object, QObject *receiver, QSSchemaRegistry::ChangedCallback onChanged) {
+        observe(*static_cast<T*>(object), receiver, onChanged);
+    };
+    entry.signalCount = int(fieldNames.size()) + 1;
+
+    QSSchemaRegistry::registerEntry(&T::staticMetaObject, entry);
+}
+
+} // namespace QSSchema
+
+#endif // QSSCHEMA_H
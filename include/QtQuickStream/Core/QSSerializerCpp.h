@@ -0,0 +1,77 @@
+#ifndef QSSERIALIZERCPP_H
+#define QSSERIALIZERCPP_H
+
+#include <QHash>
+#include <QObject>
+#include <QVariant>
+#include <qqml.h>
+
+class QSObjectCpp;
+
+/*! ***********************************************************************************************
+ * QSSerializerCpp is the native counterpart of QSSerializer.qml. It transforms QObjects into plain
+ * property maps in which registered QSObjects are replaced by their QtQuickStream URL (qqs:/UUID).
+ *
+ * It is also available in QML as singleton, e.g., QSSerializer.qml uses isEqual() to only write
+ * properties that really changed, and encodeValue()/decodeValue() to store value types tagged with
+ * their type (see QSValueCodecs).
+ *
+ * \note    The result only holds plain values (no QObject pointers), so it can be handed to other
+ *          threads. Reading the properties must still happen on the thread owning the objects.
+ * ************************************************************************************************/
+class QSSerializerCpp : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit QSSerializerCpp(QObject *parent = nullptr);
+
+    /* Public Static Functions
+     * ****************************************************************************************/
+    static QVariantMap  getQSProps              (const QObject *object);
+    static QVariant     getQSProp               (const QVariant &propValue);
+
+    static QString      getQSUrl                (const QSObjectCpp *qsObject);
+    static bool         isPropertyBlackListed   (const QByteArray &propName);
+    static bool         isRegisteredQSObject    (const QObject *object);
+    static void         collectQSUrls           (const QVariant &qsProp, QStringList &uuidStrs);
+    static void         collectReferences       (const QVariant &propValue, QStringList &uuidStrs);
+    static QVariant     removeReference         (const QVariant &propValue, const QObject *target);
+
+    static QVariant     toPlainValue            (const QVariant &value);
+    static bool         isEqualValue            (const QVariant &lhs, const QVariant &rhs);
+    static QByteArray   toCompactJson           (const QVariant &qsProp);
+    static qint64       estimateSize            (const QVariant &value);
+    static int          propertyIndexForSignal  (const QMetaObject *metaObject, int signalIndex);
+
+    /* Public Static Attributes
+     * ****************************************************************************************/
+    //! Identifier for QtQuickStream object references
+    static const QString protoString;
+
+public slots:
+    /* Public Slots
+     * ****************************************************************************************/
+    bool                isEqual                 (const QVariant &lhs, const QVariant &rhs) const;
+
+    QVariant            encodeValue             (const QVariant &value) const;
+    QVariant            encodeEnumProp          (const QObject *object, const QString &propName) const;
+    QVariant            decodeValue             (const QVariantMap &qsValue) const;
+    QStringList         getEnumPropNames        (const QObject *object);
+
+    bool                hasSchema               (const QObject *object) const;
+    QVariantMap         getSchemaProps          (const QObject *object) const;
+    QVariantMap         applySchemaProps        (QObject *object, const QVariantMap &qsProps) const;
+
+private:
+    /* Attributes
+     * ****************************************************************************************/
+    //! Enum property names by type (used by QSSerializer.getQSProps())
+    QHash<QByteArray, QStringList> m_enumPropNames;
+};
+
+#endif // QSSERIALIZERCPP_H
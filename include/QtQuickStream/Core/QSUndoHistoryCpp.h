@@ -0,0 +1,155 @@
+#ifndef QSUNDOHISTORYCPP_H
+#define QSUNDOHISTORYCPP_H
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QVariant>
+#include <qqml.h>
+
+class QSObjectCpp;
+class QSObjectListCpp;
+class QSRepositoryCpp;
+
+/*! ***********************************************************************************************
+ * QSUndoHistoryCpp records the changes of a QSRepositoryCpp (property values, object additions and
+ * deletions) as undoable commands. Only the changed values are stored, so undo steps do not
+ * require serializing the repository.
+ *
+ * Changes recorded between beginCommand() and endCommand() form a single command, all other
+ * changes become a command of their own. Oldest commands are dropped when byteBudget is exceeded.
+ * The copy of the last known property values is needed for recording regardless of the number of
+ * commands, it is not part of the budget but reported separately (see capturedBytes).
+ *
+ * Object references in values are guarded: references to destroyed objects are resolved by UUID
+ * through the repo when applied (or become null). Object lists (QSObjectListCpp) are recorded by
+ * their elements, so insertions, removals and moves can be undone.
+ *
+ * \note    Disabled by default, as it keeps a copy of the last known property values
+ * \note    Deleted objects can only be restored as long as they were not destroyed
+ * ************************************************************************************************/
+class QSUndoHistoryCpp : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool         enabled     READ isEnabled      WRITE setEnabled    NOTIFY enabledChanged)
+    Q_PROPERTY(qint64       byteBudget  READ getByteBudget  WRITE setByteBudget NOTIFY byteBudgetChanged)
+    Q_PROPERTY(qint64       usedBytes   READ getUsedBytes                       NOTIFY historyChanged)
+    Q_PROPERTY(qint64       capturedBytes READ getCapturedBytes                 NOTIFY historyChanged)
+    Q_PROPERTY(bool         canUndo     READ canUndo                            NOTIFY historyChanged)
+    Q_PROPERTY(bool         canRedo     READ canRedo                            NOTIFY historyChanged)
+    Q_PROPERTY(QString      undoText    READ getUndoText                        NOTIFY historyChanged)
+    Q_PROPERTY(QString      redoText    READ getRedoText                        NOTIFY historyChanged)
+    QML_ELEMENT
+    QML_UNCREATABLE("QSUndoHistoryCpp is provided by QSRepositoryCpp")
+
+public:
+    /* Public Constructors & Destructor
+     * ****************************************************************************************/
+    explicit QSUndoHistoryCpp(QSRepositoryCpp *repo);
+
+    /* Public Getters & Setters
+     * ****************************************************************************************/
+    bool                isEnabled       () const;
+    qint64              getByteBudget   () const;
+    qint64              getUsedBytes    () const;
+    qint64              getCapturedBytes() const;
+    bool                canUndo         () const;
+    bool                canRedo         () const;
+    QString             getUndoText     () const;
+    QString             getRedoText     () const;
+
+    void                setEnabled      (bool enabled);
+    void                setByteBudget   (qint64 byteBudget);
+
+    /* Public Functions (called by the repository)
+     * ****************************************************************************************/
+    void                recordAdded     (const QString &uuidStr, QSObjectCpp *qsObject);
+    void                recordDeleted   (const QString &uuidStr, QSObjectCpp *qsObject);
+    void                recordChanged   (QSObjectCpp *qsObject, int propertyIndex);
+
+    void                captureObject   (QSObjectCpp *qsObject);
+    void                releaseObject   (QSObjectCpp *qsObject);
+
+    qint64              getObjectBytes  (const QSObjectCpp *qsObject) const;
+    bool                holdsObject     (const QSObjectCpp *qsObject) const;
+
+public slots:
+    /* Public Slots
+     * ****************************************************************************************/
+    void                beginCommand    (const QString &text = QString());
+    void                endCommand      ();
+
+    bool                undo            ();
+    bool                redo            ();
+    void                clear           ();
+
+signals:
+    /* Signals
+     * ****************************************************************************************/
+    void                enabledChanged();
+    void                byteBudgetChanged();
+    void                historyChanged();
+
+private:
+    /* Private Types
+     * ****************************************************************************************/
+    struct Change {
+        enum Kind { Property, Added, Deleted };
+
+        Kind                    kind;
+        QString                 uuidStr;
+        QPointer<QSObjectCpp>   qsObject;
+        int                     propertyIndex;
+        QVariant                before;
+        QVariant                after;
+    };
+
+    struct Command {
+        QString                 text;
+        QList<Change>           changes;
+        qint64                  bytes = 0;
+    };
+
+    /* Private Functions
+     * ****************************************************************************************/
+    void                record          (Change &&change);
+    void                recordProperty  (QSObjectCpp *qsObject, QHash<int, QVariant> &values,
+                                         int propertyIndex);
+    QVariant            readValue       (QSObjectCpp *qsObject, int propertyIndex) const;
+    void                writeValue      (QSObjectCpp *qsObject, int propertyIndex,
+                                         const QVariant &value) const;
+    QVariant            resolveValue    (const QVariant &value) const;
+    void                pushCommand     (Command &&command);
+    void                applyCommand    (const Command &command, bool isUndo);
+    void                trimToBudget    ();
+
+    static QVariant     guardValue      (const QVariant &value);
+    static bool         refersTo        (const QVariant &value, const QSObjectCpp *qsObject);
+    static QSObjectListCpp *toObjectList(const QVariant &value);
+    static qint64       estimateBytes   (const Change &change);
+    static qint64       estimateBytes   (const QHash<int, QVariant> &values);
+
+    /* Attributes
+     * ****************************************************************************************/
+    QSRepositoryCpp    *m_repo;
+
+    bool                m_enabled;
+    bool                m_isApplying;
+    qint64              m_byteBudget;
+    qint64              m_usedBytes;        //!< Memory of the recorded commands
+    qint64              m_capturedBytes;    //!< Memory of the last known values (see m_values)
+
+    QList<Command>      m_commands;
+    int                 m_index;            //!< Number of commands that are currently applied
+
+    int                 m_commandDepth;
+    Command             m_openCommand;
+
+    //! Index of (object, property) changes within the open command, used to merge changes
+    QHash<QPair<const QObject*, int>, qsizetype>    m_openPropertyChanges;
+
+    //! Last known (plain, guarded) property values by object and property index, used as 'before'
+    QHash<const QObject*, QHash<int, QVariant>>     m_values;
+};
+
+#endif // QSUNDOHISTORYCPP_H
@@ -0,0 +1,48 @@
+#ifndef QSVALUECODECS_H
+#define QSVALUECODECS_H
+
+#include <QMetaEnum>
+#include <QMetaType>
+#include <QVariantMap>
+
+#include <functional>
+
+/*! ***********************************************************************************************
+ * QSValueCodecs is the registry of codecs for Qt value types. A codec stores a value as a map
+ * tagged with its type, e.g., { "qsValueType": "vector2d", "x": 1, "y": 2 }.
+ *
+ * Encoding dispatches on the QMetaType id of the value and decoding on the stored tag, so values
+ * are restored without probing the stored map or the current property value. Codecs for
+ * QVector2D/3D, QPoint(F), QSize(F), QRect(F), QColor, QDateTime and QUrl are built in, enums are
+ * encoded from their QMetaEnum (see encodeEnum()).
+ *
+ * \note    Registering codecs is thread safe, but should happen before values are serialized
+ * ************************************************************************************************/
+class QSValueCodecs
+{
+public:
+    /* Public Types
+     * ****************************************************************************************/
+    //! Returns the fields of value (without tag)
+    using Encoder = std::function<QVariantMap(const QVariant &value)>;
+    //! Returns the value of fields (invalid if fields are incomplete)
+    using Decoder = std::function<QVariant(const QVariantMap &fields)>;
+
+    /* Public Static Functions
+     * ****************************************************************************************/
+    static void         registerCodec   (QMetaType metaType, const QString &tag,
+                                         const Encoder &encoder, const Decoder &decoder);
+    static bool         hasCodec        (QMetaType metaType);
+
+    static QVariant     encode          (const QVariant &value);
+    static QVariant     encodeEnum      (const QMetaEnum &metaEnum, int value);
+    static QVariant     decode          (const QVariantMap &qsValue);
+    static bool         isEncoded       (const QVariantMap &qsValue);
+
+    /* Public Static Attributes
+     * ****************************************************************************************/
+    //! Key of the type tag in encoded values
+    static const QString typeKey;
+};
+
+#endif // QSVALUECODECS_H
@@ -23,7 +23,13 @@ QSObjectCpp {
      * ****************************************************************************************/
     //! Adds element to container and emits containerChangedSignal
     //! \note this takes parentship of the element
+    //! \note QSObjectListCpp containers take care of this themselves (and emit row signals)
     function addElement(container, element: QSObject, containerChangedSignal, emit = true) {
+        if (container?._qsIsObjectList) {
+            container.append(element);
+            return;
+        }
+
         // Sanity check
         if (container[element._qsUuid] === element) { return; }
 
@@ -40,38 +46,58 @@ QSObjectCpp {
 
     //! Adds/removes element from/to container to match elements and emits containerChangedSignal
     //! \note this is more efficient than adding/removing multiple times
+    //! \note the container is reordered in place, so it must be the actual container property
     function setElements(container, elements, containerChangedSignal) {
-        let oldElements = Object.values(container);
         let newElements = Object.values(elements);
 
+        if (container?._qsIsObjectList) {
+            container.setElements(newElements);
+            return;
+        }
+
+        let oldElements = Object.values(container);
+
         // Sanity check
-        if (oldElements.equals(newElements)) { return; }
+        if (oldElements.length === newElements.length
+                && oldElements.every((element, index) => element === newElements[index])) {
+            return;
+        }
 
-        let toRemove    = oldElements.filter(x => !newElements.includes(x));
-        let toAdd       = newElements.filter(x => !oldElements.includes(x));
+        let oldElementSet = new Set(oldElements);
+        let newElementSet = new Set(newElements);
 
-        for (let i in toRemove) {
-            removeElement(container, toRemove[i], containerChangedSignal, false);
+        for (const element of oldElements) {
+            if (!newElementSet.has(element)) {
+                removeElement(container, element, containerChangedSignal, false);
+            }
         }
 
-        for (let j in toAdd) {
-            addElement(container, toAdd[j], containerChangedSignal, false);
+        for (const element of newElements) {
+            if (!oldElementSet.has(element)) {
+                addElement(container, element, containerChangedSignal, false);
+            }
         }
 
-        // Generate new container to preserve order
-        let tempContainer = {};
-        for (let element in newElements) {
-            tempContainer[element._qsUuid] = element;
+        // Re-insert all elements to preserve order
+        for (const key of Object.keys(container)) {
+            delete container[key];
+        }
+        for (const element of newElements) {
+            container[element._qsUuid] = element;
         }
 
-        // Allocate and inform observers
-        container = tempContainer;
+        // Inform observers
         containerChangedSignal();
     }
 
     //! Removes element from container and emits containerChangedSignal
     //! \note this gives up parentship of the element
     function removeElement(container, element: QSObject, containerChangedSignal, emit = true) {
+        if (container?._qsIsObjectList) {
+            container.remove(element);
+            return;
+        }
+
         // Sanity check
         if (container[element._qsUuid] === undefined) {
             console.warn("Attempted to remove unknown element: " + element?._qsUuid);
@@ -85,7 +111,6 @@ QSObjectCpp {
         element._qsRepo = null;
         element._qsParent = null;
 
-        // Inform obersvers
         // Inform obersvers
         if (emit) { containerChangedSignal(); }
     }
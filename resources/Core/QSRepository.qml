@@ -79,9 +79,10 @@ QSRepositoryCpp {
      * SERIALIZATION
      * ****************************************************************************************/
     /*! ***************************************************************************************
-     * Returns a dump of all objects' properties, in which qsobject references are URLs.
+     * Returns a dump of all objects' properties (or those of objIds), in which qsobject
+     * references are URLs.
      * ****************************************************************************************/
-    function dumpRepo(serialType = QSSerializer.SerialType.STORAGE) : object
+    function dumpRepo(serialType = QSSerializer.SerialType.STORAGE, objIds = undefined) : object
     {
         var jsonObjects = {};
 
@@ -94,9 +95,9 @@ QSRepositoryCpp {
         jsonObjects[hashedAppKey] = hashedAppName;
 
         // Build tree from all objects' attributes (replacing references by UUIDs)
-        for (const [objId, qsObj] of Object.entries(_qsObjects)) {
+        for (const objId of objIds ?? Object.keys(_qsObjects)) {
             try {
-                jsonObjects[objId] = QSSerializer.getQSProps(qsObj, serialType);
+                jsonObjects[objId] = QSSerializer.getQSProps(findObject(objId), serialType);
             } catch (e) {
                 console.warn("[QSRepo] " + e.message);
             }
@@ -107,6 +108,15 @@ QSRepositoryCpp {
         return jsonObjects;
     }
 
+    /*! ***************************************************************************************
+     * Returns the properties of qsObj as dumpRepo() saves them. Content hashes, snapshots and
+     * evicted objects are serialized through this function (see QSRepositoryCpp).
+     * ****************************************************************************************/
+    function storageProps(qsObj)
+    {
+        return QSSerializer.getQSProps(qsObj, QSSerializer.SerialType.STORAGE);
+    }
+
     /*! ***************************************************************************************
      * Creates all objects' properties, in which qsobject references are URLs.
      * ****************************************************************************************/
@@ -115,37 +125,13 @@ QSRepositoryCpp {
         //! Satrt the loading process
         _isLoading = true;
 
-        /* 0. Validate the file
+        /* 0./1. Validate the file and check version
          * ********************************************************************************/
-
-        //! Hash the application name and its key
-        var hashedAppKey     = HashStringCPP.hexHashString(_applicationKey);
-        var hashedAppName    = jsonObjects[hashedAppKey];
-        var hashRealAppName  = HashStringCPP.hexHashString(_applicationName);
-
-        if (hashedAppName.length !== 0 && !HashStringCPP.compareStringModels(hashedAppName, hashRealAppName)) {
-            console.warn("[QSRepo] The file is unrelated to the application, failed.");
+        if (!checkFileHeader(jsonObjects)) {
             _isLoading = false;
             return false;
         }
 
-        delete jsonObjects[hashedAppKey];
-
-        /* 1. Check version
-         * ********************************************************************************/
-
-        var versionString = jsonObjects[_versionKey];
-        if (_supported_minimum_version.length > 0) {
-            console.warn("[QSRepo] Loading Version ", versionString);
-            if (!versionString || !checkApplicationVersion(versionString) || !checkSupportedVersion(versionString)) {
-                console.warn("[QSRepo] Version not supported, failed. Minimum spported version is ", _supported_minimum_version);
-                _isLoading = false;
-                return false
-            }
-        }
-
-        delete jsonObjects[_versionKey];
-
         /* 2. Validate Object Map
          * ********************************************************************************/
         if (jsonObjects[_rootkey] === undefined) {
@@ -158,20 +144,20 @@ QSRepositoryCpp {
         var rootUrl = jsonObjects[_rootkey];
         delete jsonObjects[_rootkey];
 
-        /* 3. Create objects
+        /* 3. Delete unneeded objects (first, so they can be recycled when creating objects)
          * ********************************************************************************/
-        loadQSObjects(jsonObjects);
+        if (deleteOldObjects) {
+            let oldObjIds  = Object.keys(_qsObjects).filter(objId => !(objId in jsonObjects));
+            let oldObjects = oldObjIds.map(objId => findObject(objId));
+
+            // The pool only takes objects that are no longer referenced (incl. by undo)
+            delObjects(oldObjIds);
+            oldObjects.forEach(qsObj => _objectPool.recycle(qsObj));
+        }
 
-        /* 4. Delete unneeded objects
+        /* 4. Create objects
          * ********************************************************************************/
-        if (deleteOldObjects) {
-            Object.keys     (_qsObjects)
-                  .filter   (objId => !(objId in jsonObjects))
-                  .forEach  (objId =>
-            {
-                delObject(objId)
-            });
-        };
+        loadQSObjects(jsonObjects);
 
         /* 5. Set root object
          * ********************************************************************************/
@@ -194,6 +180,41 @@ QSRepositoryCpp {
         //! Finish the loading process
         _isLoading = false;
 
+        // Loaded state is the new baseline for undo and change detection
+        _undoHistory.clear();
+        markPersisted();
+
+        return true;
+    }
+
+    /*! ***************************************************************************************
+     * Validates the application and version entries of a file, and removes them from the map.
+     * ****************************************************************************************/
+    function checkFileHeader(jsonObjects: object) : bool
+    {
+        //! Hash the application name and its key
+        var hashedAppKey     = HashStringCPP.hexHashString(_applicationKey);
+        var hashedAppName    = jsonObjects[hashedAppKey] ?? "";
+        var hashRealAppName  = HashStringCPP.hexHashString(_applicationName);
+
+        if (hashedAppName.length !== 0 && !HashStringCPP.compareStringModels(hashedAppName, hashRealAppName)) {
+            console.warn("[QSRepo] The file is unrelated to the application, failed.");
+            return false;
+        }
+
+        delete jsonObjects[hashedAppKey];
+
+        var versionString = jsonObjects[_versionKey];
+        if (_supported_minimum_version.length > 0) {
+            console.warn("[QSRepo] Loading Version ", versionString);
+            if (!versionString || !checkApplicationVersion(versionString) || !checkSupportedVersion(versionString)) {
+                console.warn("[QSRepo] Version not supported, failed. Minimum spported version is ", _supported_minimum_version);
+                return false
+            }
+        }
+
+        delete jsonObjects[_versionKey];
+
         return true;
     }
 
@@ -207,18 +228,26 @@ QSRepositoryCpp {
          * ********************************************************************************/
         // Read baseline properties
         for (const [objId, jsonObj] of Object.entries(jsonObjects)) {
-            if (objId in _qsObjects) {
+            if (findObject(objId)) {
                 console.log("[QSRepo] Skipping creation of: " + objId + " " + jsonObj.qsType);
                 continue;
             }
 
             try {
-                var qsObj = QSSerializer.createQSObject(
+                // Reuse recycled objects before instantiating new ones (the loaded properties
+                // are written below, as for new objects)
+                var qsObj = _objectPool.acquire(jsonObj.qsType, jsonObj);
+
+                if (!qsObj) {
+                    qsObj = QSSerializer.createQSObject(
                                 jsonObj.qsType, _allImports, repo
                              );
 
-                // Skip further processing if failed
-                if (!qsObj) { continue; }
+                    // Skip further processing if failed
+                    if (!qsObj) { continue; }
+
+                    _objectPool.captureDefaults(qsObj);
+                }
 
                 qsObj._qsUuid = objId;
                 qsObj._qsRepo = repo;
@@ -234,9 +263,12 @@ QSRepositoryCpp {
          * ********************************************************************************/
         // Replace all qs://UUID properties by references
         for (const [objId, jsonObj] of Object.entries(jsonObjects)) {
-            QSSerializer.fromQSUrlProps(_qsObjects[objId], jsonObj, repo);
+            QSSerializer.fromQSUrlProps(findObject(objId), jsonObj, repo);
         }
 
+        // Index the references now that URLs are resolved
+        updateReferences(Object.keys(jsonObjects));
+
 
         return true;
     }
@@ -249,6 +281,13 @@ QSRepositoryCpp {
      * ****************************************************************************************/
     function loadFromFile(fileName: variant) : bool
     {
+        // Indexed files are loaded on demand
+        if (isIndexedFile(fileName)) {
+            return loadFromIndexedFile(fileName);
+        }
+
+        closeIndexedFile();
+
         // Read file
         var jsonString = QSFileIO.read(fileName);
 
@@ -263,6 +302,119 @@ QSRepositoryCpp {
         return loadRepo(fileObjects);
     }
 
+    /*! ***************************************************************************************
+     * Opens an indexed file and only loads the root object (and the objects that are already
+     * present). Other objects are paged in when resolved (see pageInObjects()).
+     * ****************************************************************************************/
+    function loadFromIndexedFile(fileName: variant) : bool
+    {
+        //! Start the loading process
+        _isLoading = true;
+
+        if (!openIndexedFile(fileName)) {
+            console.warn("[QSRepo] Could not open indexed file, failed.");
+            _isLoading = false;
+            return false;
+        }
+
+        var meta = getIndexedFileMeta();
+        if (!checkFileHeader(meta) || meta[_rootkey] === undefined) {
+            closeIndexedFile();
+            _isLoading = false;
+            return false;
+        }
+
+        // Drop objects that are not part of the file
+        delObjects(Object.keys(_qsObjects).filter(objId => !isIndexedObject(objId)));
+
+        // Load root and reload present objects, objects they reference are paged in when their
+        // URLs are resolved (see QSSerializer.resolveQSUrl())
+        var rootUrl     = meta[_rootkey];
+        var jsonObjects = readIndexedObjects([ ...Object.keys(_qsObjects),
+                                               rootUrl.substring(QSSerializer.protoStrLen) ],
+                                             false);
+        loadQSObjects(jsonObjects);
+
+        let rootObj = QSSerializer.resolveQSUrl(rootUrl, repo);
+        if (qsRootObject && rootObj && rootObj._qsUuid !== qsRootObject._qsUuid)
+            qsRootObject.destroy();
+
+        qsRootObject = rootObj;
+
+        for (const objId of Object.keys(jsonObjects)) {
+            findObject(objId)?.loadedFromStorage();
+        }
+
+        //! Finish the loading process
+        _isLoading = false;
+
+        // Loaded state is the new baseline for undo and change detection
+        _undoHistory.clear();
+        markPersisted();
+
+        return true;
+    }
+
+    /*! ***************************************************************************************
+     * Loads paged out objects from the indexed file. Paged out objects they reference are
+     * loaded when their URLs are resolved (see QSSerializer.resolveQSUrl()).
+     * ****************************************************************************************/
+    function pageInObjects(objIds: var) : bool
+    {
+        return loadIndexedObjects(readIndexedObjects(objIds.filter(objId => isPagedOut(objId)),
+                                                     false));
+    }
+
+    /*! ***************************************************************************************
+     * Loads the subgraphs of the given objects ahead of their first use.
+     * ****************************************************************************************/
+    function prefetchObjects(objIds: var) : bool
+    {
+        return loadIndexedObjects(readIndexedObjects(objIds.filter(objId => isPagedOut(objId))));
+    }
+
+    /*! ***************************************************************************************
+     * Loads objects read from the indexed file (see readIndexedObjects())
+     * ****************************************************************************************/
+    function loadIndexedObjects(jsonObjects: object) : bool
+    {
+        // Sanity check: nothing to load
+        if (Object.keys(jsonObjects).length === 0) { return false; }
+
+        var wasLoading = _isLoading;
+        _isLoading = true;
+
+        loadQSObjects(jsonObjects);
+        markPersisted(Object.keys(jsonObjects));
+
+        _isLoading = wasLoading;
+
+        for (const objId of Object.keys(jsonObjects)) {
+            findObject(objId)?.loadedFromStorage();
+        }
+
+        return true;
+    }
+
+    /*! ***************************************************************************************
+     * Stores the repo and all its objects to an indexed file (paged out objects are kept)
+     * ****************************************************************************************/
+    function saveToIndexedFile(fileName: variant) : bool
+    {
+        console.log("[QSRepo] Saving Repo to Indexed File: " + fileName);
+
+        // Unchanged objects are copied from the open indexed file
+        let objIds = isIndexedFileOpen() ? getChangedObjectIds() : undefined;
+
+        if (!writeIndexedFile(fileName, dumpRepo(QSSerializer.SerialType.STORAGE, objIds))) {
+            return false;
+        }
+
+        markPersisted();
+
+        return true;
+    }
+
     /*! ***************************************************************************************
      * Stores the repo and all its objects to a file
      * ****************************************************************************************/
@@ -271,11 +423,20 @@ QSRepositoryCpp {
         console.log("[QSRepo] Saving Repo to File: " + fileName);
         console.log(QSSerializer.SerialType.STORAGE);
 
+        // Plain files are complete, load all paged out objects first
+        pageInObjects(getPagedOutIds());
+
         // Get the objects for storage
         let repoDump = dumpRepo(QSSerializer.SerialType.STORAGE);
 
         // Store the tree to file
-        return QSFileIO.write(fileName, JSON.stringify(repoDump, null, 4));
+        if (!QSFileIO.write(fileName, JSON.stringify(repoDump, null, 4))) {
+            return false;
+        }
+
+        markPersisted();
+
+        return true;
     }
 
     /*! ***************************************************************************************
@@ -355,11 +516,12 @@ QSRepositoryCpp {
         if (savedVersion.length > 0) {
             var versionArraySaved = savedVersion.split(".");
             if (versionArraySaved.length > 0) {
-                var majorVersionSaved = versionArraySaved[0];
+                var majorVersionSaved = parseInt(versionArraySaved[0]);
 
                 var versionArrayApp = _version.split(".");
-                var majorVersionApp = versionArrayApp[0];
+                var majorVersionApp = parseInt(versionArrayApp[0]);
 
+                // Compare numbers, not strings ("10" < "9") -- same rule as QSRepositoryFile
                 var isValidVersion  = majorVersionApp >= majorVersionSaved;
 
                 if (!isValidVersion)
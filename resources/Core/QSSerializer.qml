@@ -53,6 +53,11 @@ QtObject {
     //! and handles some other problematic data types
     function fromQSUrlProps(obj, props, repo: QSRepository) : object
     {
+        // Types with a schema apply their fields natively, the rest is applied below
+        if (Qt.isQtObject(obj) && QSSerializerCpp.hasSchema(obj)) {
+            props = QSSerializerCpp.applySchemaProps(obj, props);
+        }
+
         // Go over all props
         for (const [propName, propVal] of Object.entries(props)) {
             //! \todo Skip readonly properties
@@ -64,8 +69,9 @@ QtObject {
                 // Get temporary (will overwrite sub-properties of old prop value)
                 let oldPropVal = obj[propName];
                 let tmpPropVal = fromQSUrlProp(oldPropVal, propVal, repo);
-                // Skip if equal, overwrite if different
-                if (tmpPropVal !== oldPropVal) {
+                // Skip if (structurally) equal, overwrite if different
+                if (tmpPropVal !== oldPropVal
+                        && !QSSerializerCpp.isEqual(tmpPropVal, oldPropVal)) {
                     obj[propName] = tmpPropVal;
                 }
             } catch (e) {
@@ -90,12 +96,20 @@ QtObject {
             // Replace url by object
             return resolveQSUrl(propValue, repo);
         }
+        // Fill object lists in place (stored as list of references)
+        else if (objProp?._qsIsObjectList) {
+            objProp.setElements(Object.values(propValue).map(qsUrl => resolveQSUrl(qsUrl, repo)));
+            return objProp;
+        }
         // Handle objects (property maps)
         else if (typeof propValue === "object") {
-            // Handle vector types
-            //! \todo this should be based on the propValue, not the objProp
-            //! \note hopefully this wont be needed in a future qt version
-            if (isQVector(objProp)) {
+            // Decode value types by their type tag (vectors, dates, colors, ...)
+            if (propValue.qsValueType !== undefined) {
+                return QSSerializerCpp.decodeValue(propValue);
+            }
+            // Handle (untagged) vector types of older files
+            //! \note this is based on the objProp, tagged values are decoded above
+            else if (isQVector(objProp)) {
                 return Qt.vector2d(propValue["x"], propValue["y"]);
 
             } else  if (isQSize(objProp)) {
@@ -139,11 +153,19 @@ QtObject {
                                    && obj?._qsInterfaceType;
         const handleAsUnavailable   = (serialType === QSSerializer.SerialType.STORAGE);
 
+        // Types with a schema are serialized natively
+        if (!handleAsInterface && Qt.isQtObject(obj) && QSSerializerCpp.hasSchema(obj)) {
+            return QSSerializerCpp.getSchemaProps(obj);
+        }
+
         // Get list of interface properties if applicable
         const ifacePropNames        = handleAsInterface ? obj.getInterfacePropNames() : [];
 
         let objectSimpleProps = {};
 
+        // Enums are tagged based on the property (the value is a plain number)
+        const enumPropNames         = Qt.isQtObject(obj) ? QSSerializerCpp.getEnumPropNames(obj) : [];
+
         // Serialize all properties that are not blacklisted
         for (const [propName, propVal] of Object.entries(obj)) {
             // Skip blacklisted properties
@@ -151,7 +173,9 @@ QtObject {
             // Skip non-interface propnames
             if (handleAsInterface && !ifacePropNames.includes(propName))    { continue; }
 
-            objectSimpleProps[propName] = getQSProp(propVal, serialType);
+            objectSimpleProps[propName] = enumPropNames.includes(propName)
+                                        ? QSSerializerCpp.encodeEnumProp(obj, propName)
+                                        : getQSProp(propVal, serialType);
         }
 
         // Overwrite type by interface if only interfaces requested
@@ -174,22 +198,24 @@ QtObject {
             if (isRegisteredQSObject(propValue)) {
                 return getQSUrl(propValue);
             }
-            // Handle dates
-            else if (propValue instanceof Date) {
-                try {
-                    return propValue.toISOString();
-                } catch (e) {
-                    return null;
-                }
+            // Store object lists as list of references
+            else if (propValue._qsIsObjectList) {
+                return propValue.elements.map(elem => getQSUrl(elem));
             }
             // Handle arrays
             else if (Array.isArray(propValue)) {
                 return propValue.map(elem => getQSProp(elem, serialType));
             }
-            // Recurse
-            else {
+            // Recurse on QObjects and property maps
+            else if (Qt.isQtObject(propValue)
+                        || Object.getPrototypeOf(propValue) === Object.prototype) {
                 return getQSProps(propValue, serialType);
             }
+            // Tag value types (vectors, dates, colors, ...) by their type, recurse if unknown
+            else {
+                return QSSerializerCpp.encodeValue(propValue)
+                        ?? getQSProps(propValue, serialType);
+            }
         }
 
         return propValue;
@@ -214,7 +240,7 @@ QtObject {
     }
 
     //! Returns whether the object is a Qt vector.
-    //! \todo Terrible performance - hopefully not needed in future Qt versions
+    //! \note Only used for untagged values of older files (slow, see QSValueCodecs)
     function isQVector(obj) : bool
     {
         if(!obj || obj === undefined)
@@ -228,7 +254,7 @@ QtObject {
     }
 
     //! Returns whether the object is a Qt Size.
-    //! \todo Terrible performance - hopefully not needed in future Qt versions
+    //! \note Only used for untagged values of older files (slow, see QSValueCodecs)
     function isQSize(obj) : bool
     {
         if(!obj || obj === undefined)
@@ -261,9 +287,16 @@ QtObject {
     {
         if (typeof qsUrl === "string" && qsUrl.startsWith(protoString)) {
             var uuid = qsUrl.substring(protoStrLen);
-            return repo._qsUuid === uuid
-                 ? repo
-                 : repo._qsObjects[uuid];
+            if (repo._qsUuid === uuid) {
+                return repo;
+            }
+
+            // Load on demand when repo is read from an indexed file
+            if (repo.isPagedOut(uuid)) {
+                repo.pageInObjects?.([uuid]);
+            }
+
+            return repo.findObject(uuid);
         } else {
             return null;
         }
@@ -1,6 +1,36 @@
 #include "HashStringCPP.h"
 
 #include <QCryptographicHash>
+#include <QtEndian>
+
+namespace {
+
+// XXH64 primes
+constexpr quint64 xxPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr quint64 xxPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr quint64 xxPrime3 = 0x165667B19E3779F9ULL;
+constexpr quint64 xxPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr quint64 xxPrime5 = 0x27D4EB2F165667C5ULL;
+
+inline quint64 xxRotl(quint64 x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+inline quint64 xxRound(quint64 acc, quint64 input)
+{
+    acc += input * xxPrime2;
+    acc  = xxRotl(acc, 31);
+    return acc * xxPrime1;
+}
+
+inline quint64 xxMerge(quint64 acc, quint64 val)
+{
+    acc ^= xxRound(0, val);
+    return acc * xxPrime1 + xxPrime4;
+}
+
+} // namespace
 
 
 /* ************************************************************************************************
@@ -60,3 +90,85 @@ bool HashStringCPP::compareStringModels(QString strModelFirst, QString strModelS
 
     return (modelFirst.compare(modelSecound) == 0);
 }
+
+
+/* ************************************************************************************************
+ * Public Static Functions
+ * ************************************************************************************************/
+
+/*!
+ * \brief HashStringCPP::hash64 Hash data with XXH64 (compatible with the reference
+ * implementation, so hashes can be compared across processes).
+ *
+ * \param data is the data that be hash.
+ * \param seed is the seed of the hash.
+ */
+quint64 HashStringCPP::hash64(const QByteArray &data, quint64 seed)
+{
+    const uchar *p   = reinterpret_cast<const uchar*>(data.constData());
+    const uchar *end = p + data.size();
+    quint64      hash;
+
+    // Process stripes of 32 bytes
+    if (data.size() >= 32) {
+        quint64 v1 = seed + xxPrime1 + xxPrime2;
+        quint64 v2 = seed + xxPrime2;
+        quint64 v3 = seed;
+        quint64 v4 = seed - xxPrime1;
+
+        const uchar *limit = end - 32;
+        do {
+            v1 = xxRound(v1, qFromLittleEndian<quint64>(p));
+            v2 = xxRound(v2, qFromLittleEndian<quint64>(p + 8));
+            v3 = xxRound(v3, qFromLittleEndian<quint64>(p + 16));
+            v4 = xxRound(v4, qFromLittleEndian<quint64>(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        hash = xxRotl(v1, 1) + xxRotl(v2, 7) + xxRotl(v3, 12) + xxRotl(v4, 18);
+        hash = xxMerge(hash, v1);
+        hash = xxMerge(hash, v2);
+        hash = xxMerge(hash, v3);
+        hash = xxMerge(hash, v4);
+    } else {
+        hash = seed + xxPrime5;
+    }
+
+    hash += quint64(data.size());
+
+    // Process remaining bytes
+    for (; p + 8 <= end; p += 8) {
+        hash ^= xxRound(0, qFromLittleEndian<quint64>(p));
+        hash  = xxRotl(hash, 27) * xxPrime1 + xxPrime4;
+    }
+
+    if (p + 4 <= end) {
+        hash ^= quint64(qFromLittleEndian<quint32>(p)) * xxPrime1;
+        hash  = xxRotl(hash, 23) * xxPrime2 + xxPrime3;
+        p += 4;
+    }
+
+    for (; p < end; ++p) {
+        hash ^= (*p) * xxPrime5;
+        hash  = xxRotl(hash, 11) * xxPrime1;
+    }
+
+    // Avalanche
+    hash ^= hash >> 33;
+    hash *= xxPrime2;
+    hash ^= hash >> 29;
+    hash *= xxPrime3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+/*!
+ * \brief HashStringCPP::toHex64 Converts a 64 bit hash to hex (16 characters).
+ *
+ * \param hash is the hash value.
+ */
+QString HashStringCPP::toHex64(quint64 hash)
+{
+    return QString::number(hash, 16).rightJustified(16, QLatin1Char('0'));
+}
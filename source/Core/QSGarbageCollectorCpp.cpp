@@ -0,0 +1,314 @@
+#include "QSGarbageCollectorCpp.h"
+#include "QSObjectCpp.h"
+#include "QSRepositoryCpp.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+/*! Creates an (idle) collector for repo
+ * ************************************************************************************************/
+QSGarbageCollectorCpp::QSGarbageCollectorCpp(QSRepositoryCpp *repo)
+  : QObject             {repo}
+  , m_repo              (repo)
+  , m_timer             ()
+  , m_sliceMs           (4)
+  , m_pinnedIds         ()
+  , m_unreachableIds    ()
+  , m_phase             (Idle)
+  , m_deleteUnreachable (false)
+  , m_candidateIds      ()
+  , m_markedIds         ()
+  , m_grayIds           ()
+  , m_sweepIds          ()
+  , m_sweepIndex        (0)
+{
+    m_timer.setInterval(0);
+    connect(&m_timer, &QTimer::timeout, this, &QSGarbageCollectorCpp::runSlice);
+
+    // A new root is reachable by definition
+    connect(m_repo, &QSRepositoryCpp::rootObjectChanged, this, [this]() {
+        if (m_phase != Idle && m_repo->m_rootObject != nullptr) {
+            shade({ m_repo->m_rootObject->getUuidStr() });
+        }
+    });
+
+    // References are incomplete while loading
+    connect(m_repo, &QSRepositoryCpp::isLoadingChanged, this, [this]() {
+        if (m_repo->m_isLoading) { cancel(); }
+    });
+}
+
+/* ************************************************************************************************
+ * Public Getters & Setters
+ * ************************************************************************************************/
+bool QSGarbageCollectorCpp::isRunning() const
+{
+    return m_phase != Idle;
+}
+
+int QSGarbageCollectorCpp::getSliceMs() const
+{
+    return m_sliceMs;
+}
+
+QStringList QSGarbageCollectorCpp::getPinnedIds() const
+{
+    return m_pinnedIds.values();
+}
+
+/*! Returns the unreachable objects found by the last collection
+ * ************************************************************************************************/
+QStringList QSGarbageCollectorCpp::getUnreachableIds() const
+{
+    return m_unreachableIds;
+}
+
+void QSGarbageCollectorCpp::setSliceMs(int sliceMs)
+{
+    // Sanity check
+    if (m_sliceMs == sliceMs || sliceMs < 1) { return; }
+
+    m_sliceMs = sliceMs;
+    emit sliceMsChanged();
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+/*! Write barrier: marks newly referenced objects as reachable while collecting. Also reverts to
+ *  marking when sweeping, as swept objects can still be resolved by UUID.
+ * ************************************************************************************************/
+void QSGarbageCollectorCpp::shade(const QStringList &targetIds)
+{
+    // Sanity check
+    if (m_phase == Idle) { return; }
+
+    for (const QString &targetId : targetIds) {
+        markGray(targetId);
+    }
+
+    if (m_phase == Sweeping && !m_grayIds.isEmpty()) {
+        m_phase = Marking;
+    }
+}
+
+/* ************************************************************************************************
+ * Public Slots
+ * ************************************************************************************************/
+/*! Keeps the object (and everything it references) alive, regardless of the root
+ * ************************************************************************************************/
+void QSGarbageCollectorCpp::pin(const QString &uuidStr)
+{
+    // Sanity check
+    if (m_pinnedIds.contains(uuidStr)) { return; }
+
+    m_pinnedIds.insert(uuidStr);
+    shade({ uuidStr });
+
+    emit pinnedIdsChanged();
+}
+
+void QSGarbageCollectorCpp::unpin(const QString &uuidStr)
+{
+    if (m_pinnedIds.remove(uuidStr)) {
+        emit pinnedIdsChanged();
+    }
+}
+
+/*! Starts an incremental collection, finished() is emitted when done
+ * ************************************************************************************************/
+bool QSGarbageCollectorCpp::start(bool deleteUnreachable)
+{
+    if (!begin(deleteUnreachable)) { return false; }
+
+    m_timer.start();
+
+    return true;
+}
+
+/*! Runs a complete collection at once and returns the unreachable objects
+ * ************************************************************************************************/
+QStringList QSGarbageCollectorCpp::collect(bool deleteUnreachable)
+{
+    // Finish a running collection
+    if (m_phase == Idle && !begin(deleteUnreachable)) { return QStringList(); }
+
+    m_deleteUnreachable = m_deleteUnreachable || deleteUnreachable;
+    while (step()) {}
+    finish();
+
+    return m_unreachableIds;
+}
+
+/*! Aborts a running collection without reporting or deleting anything
+ * ************************************************************************************************/
+void QSGarbageCollectorCpp::cancel()
+{
+    // Sanity check
+    if (m_phase == Idle) { return; }
+
+    m_timer.stop();
+    m_phase = Idle;
+
+    m_candidateIds.clear();
+    m_markedIds.clear();
+    m_grayIds.clear();
+    m_sweepIds.clear();
+
+    emit isRunningChanged();
+}
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+/*! Advances the collection until the time slice is used up
+ * ************************************************************************************************/
+void QSGarbageCollectorCpp::runSlice()
+{
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    while (step()) {
+        if (elapsedTimer.elapsed() >= m_sliceMs) { return; }
+    }
+
+    finish();
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+/*! Takes the current objects as candidates and marks the roots
+ * ************************************************************************************************/
+bool QSGarbageCollectorCpp::begin(bool deleteUnreachable)
+{
+    // Sanity check
+    if (m_phase != Idle) {
+        qWarning() << "[QSGarbageCollector] Collection already running";
+        return false;
+    }
+
+    if (m_repo->m_isLoading) {
+        qWarning() << "[QSGarbageCollector] Cannot collect while loading";
+        return false;
+    }
+
+    // Everything would be unreachable
+    if (m_repo->m_rootObject == nullptr && m_pinnedIds.isEmpty()) {
+        qWarning() << "[QSGarbageCollector] Cannot collect without root object or pins";
+        return false;
+    }
+
+    const QStringList objectIds = m_repo->m_objects.keys();
+
+    m_deleteUnreachable = deleteUnreachable;
+    m_candidateIds      = QSet<QString>(objectIds.cbegin(), objectIds.cend());
+    m_unreachableIds.clear();
+    m_sweepIndex        = 0;
+    m_phase             = Marking;
+
+    if (m_repo->m_rootObject != nullptr) {
+        markGray(m_repo->m_rootObject->getUuidStr());
+    }
+
+    for (const QString &uuidStr : std::as_const(m_pinnedIds)) {
+        markGray(uuidStr);
+    }
+
+    emit isRunningChanged();
+
+    return true;
+}
+
+/*! Processes a single object, returns false when done
+ * ************************************************************************************************/
+bool QSGarbageCollectorCpp::step()
+{
+    switch (m_phase) {
+    case Marking: {
+        // Start (or resume) sweeping when all reachable objects are marked
+        if (m_grayIds.isEmpty()) {
+            if (m_sweepIds.isEmpty()) { m_sweepIds = m_candidateIds.values(); }
+
+            m_phase = Sweeping;
+            return true;
+        }
+
+        const QString uuidStr = m_grayIds.takeLast();
+        for (const QStringList &targetIds : m_repo->m_references.value(uuidStr)) {
+            for (const QString &targetId : targetIds) {
+                markGray(targetId);
+            }
+        }
+        return true;
+    }
+    case Sweeping: {
+        if (m_sweepIndex >= m_sweepIds.size()) { return false; }
+
+        const QString &uuidStr = m_sweepIds.at(m_sweepIndex++);
+        if (!m_markedIds.contains(uuidStr)) {
+            m_unreachableIds.append(uuidStr);
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+/*! Reports (and deletes) the unreachable objects
+ * ************************************************************************************************/
+void QSGarbageCollectorCpp::finish()
+{
+    m_timer.stop();
+
+    // Drop objects marked after they were swept, or deleted in the meantime
+    m_unreachableIds.removeIf([this](const QString &uuidStr) {
+        return m_markedIds.contains(uuidStr) || !m_repo->m_objects.contains(uuidStr);
+    });
+
+    int deletedCount = 0;
+
+    if (m_deleteUnreachable && !m_unreachableIds.isEmpty()) {
+        QList<QSObjectCpp*> ownedObjects;
+        for (const QString &uuidStr : std::as_const(m_unreachableIds)) {
+            QSObjectCpp *qsObject = m_repo->getObject(uuidStr);
+
+            if (qsObject != nullptr && qsObject->parent() == m_repo) {
+                ownedObjects.append(qsObject);
+            }
+        }
+
+        m_repo->delObjects(m_unreachableIds);
+        deletedCount = m_unreachableIds.size();
+
+        for (QSObjectCpp *qsObject : std::as_const(ownedObjects)) {
+            if (!m_repo->getObjectPool()->recycle(qsObject)) {
+                qsObject->setRepo(nullptr);
+                qsObject->deleteLater();
+            }
+        }
+    }
+
+    m_phase = Idle;
+    m_candidateIds.clear();
+    m_markedIds.clear();
+    m_grayIds.clear();
+    m_sweepIds.clear();
+
+    emit isRunningChanged();
+    emit finished(m_unreachableIds, deletedCount);
+}
+
+/*! Marks the object as reachable and queues its references
+ * ************************************************************************************************/
+void QSGarbageCollectorCpp::markGray(const QString &uuidStr)
+{
+    if (!m_markedIds.contains(uuidStr)) {
+        m_markedIds.insert(uuidStr);
+        m_grayIds.append(uuidStr);
+    }
+}
@@ -0,0 +1,211 @@
+#include "QSIndexedFileCpp.h"
+
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+const QByteArray QSIndexedFileCpp::magic = QByteArrayLiteral("QQSIDX1\n");
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+/*! Default constructor
+ * ************************************************************************************************/
+QSIndexedFileCpp::QSIndexedFileCpp()
+  : m_file      ()
+  , m_swapFile  ()
+  , m_dataOffset(0)
+  , m_meta      ()
+  , m_index     ()
+{
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+/*! Opens an indexed file and reads its header (objects are read on demand)
+ * ************************************************************************************************/
+bool QSIndexedFileCpp::open(const QString &fileName)
+{
+    close();
+
+    m_file.setFileName(fileName);
+    if (!m_file.open(QFile::ReadOnly)) { return false; }
+
+    // Validate magic and read header
+    bool isValid = (m_file.read(magic.size()) == magic);
+
+    const qint64 headerSize = isValid ? m_file.readLine().trimmed().toLongLong(&isValid) : 0;
+    const QJsonDocument header = isValid ? QJsonDocument::fromJson(m_file.read(headerSize))
+                                         : QJsonDocument();
+
+    if (!header.isObject()) {
+        qWarning() << "[QSIndexedFile] Invalid file" << fileName;
+        close();
+        return false;
+    }
+
+    m_dataOffset = m_file.pos();
+    m_meta       = header.object().value("meta").toObject().toVariantMap();
+
+    const QJsonObject index = header.object().value("index").toObject();
+    m_index.reserve(index.size());
+    for (auto it = index.constBegin(); it != index.constEnd(); ++it) {
+        const QJsonArray location = it.value().toArray();
+
+        Entry entry;
+        entry.offset = location.at(0).toInteger();
+        entry.size   = location.at(1).toInteger();
+        m_index.insert(it.key(), entry);
+    }
+
+    return true;
+}
+
+void QSIndexedFileCpp::close()
+{
+    m_file.close();
+    m_swapFile.close();
+
+    m_dataOffset = 0;
+    m_meta.clear();
+    m_index.clear();
+}
+
+bool QSIndexedFileCpp::isOpen() const
+{
+    return m_file.isOpen();
+}
+
+QString QSIndexedFileCpp::fileName() const
+{
+    return m_file.fileName();
+}
+
+/*! Returns all non-object entries (root, version, application)
+ * ************************************************************************************************/
+QVariantMap QSIndexedFileCpp::meta() const
+{
+    return m_meta;
+}
+
+QStringList QSIndexedFileCpp::objectIds() const
+{
+    return m_index.keys();
+}
+
+bool QSIndexedFileCpp::contains(const QString &uuidStr) const
+{
+    return m_index.contains(uuidStr);
+}
+
+/*! Returns whether the stored state of the object is in the swap file (see evict())
+ * ************************************************************************************************/
+bool QSIndexedFileCpp::isSwapped(const QString &uuidStr) const
+{
+    return m_index.value(uuidStr).swapped;
+}
+
+/*! Returns the stored JSON of an object (from the file or the swap file)
+ * ************************************************************************************************/
+QByteArray QSIndexedFileCpp::readRaw(const QString &uuidStr)
+{
+    const auto it = m_index.constFind(uuidStr);
+
+    // Sanity check
+    if (it == m_index.constEnd()) { return QByteArray(); }
+
+    QFile &file = it->swapped ? static_cast<QFile&>(m_swapFile) : m_file;
+    const qint64 offset = it->swapped ? it->offset : m_dataOffset + it->offset;
+
+    if (!file.seek(offset)) { return QByteArray(); }
+
+    return file.read(it->size);
+}
+
+/*! Returns the stored properties of an object
+ * ************************************************************************************************/
+QVariantMap QSIndexedFileCpp::read(const QString &uuidStr)
+{
+    return QJsonDocument::fromJson(readRaw(uuidStr)).object().toVariantMap();
+}
+
+/*! Stores the (serialized) properties of an object in the swap file
+ * ************************************************************************************************/
+bool QSIndexedFileCpp::evict(const QString &uuidStr, const QVariantMap &qsProps)
+{
+    return evictRaw(uuidStr, QJsonDocument(QJsonObject::fromVariantMap(qsProps))
+                                 .toJson(QJsonDocument::Compact));
+}
+
+/*! Stores the compact JSON of an object (see readRaw()) in the swap file
+ * ************************************************************************************************/
+bool QSIndexedFileCpp::evictRaw(const QString &uuidStr, const QByteArray &data)
+{
+    // Sanity check
+    if (!isOpen()) { return false; }
+
+    if (!m_swapFile.isOpen() && !m_swapFile.open()) {
+        qWarning() << "[QSIndexedFile] Could not open swap file";
+        return false;
+    }
+
+    Entry entry;
+    entry.offset  = m_swapFile.size();
+    entry.size    = data.size();
+    entry.swapped = true;
+
+    if (!m_swapFile.seek(entry.offset) || m_swapFile.write(data) != data.size()) {
+        return false;
+    }
+
+    m_index.insert(uuidStr, entry);
+
+    return true;
+}
+
+/* ************************************************************************************************
+ * Public Static Functions
+ * ************************************************************************************************/
+/*! Returns whether the file starts with the indexed file magic
+ * ************************************************************************************************/
+bool QSIndexedFileCpp::isIndexedFile(const QString &fileName)
+{
+    QFile file(fileName);
+
+    return file.open(QFile::ReadOnly) && file.read(magic.size()) == magic;
+}
+
+/*! Writes meta entries and objects (compact JSON by UUID) as indexed file
+ * ************************************************************************************************/
+bool QSIndexedFileCpp::write(const QString &fileName, const QVariantMap &meta,
+                             const QHash<QString, QByteArray> &objects)
+{
+    // Build index and data section
+    QJsonObject index;
+    QByteArray  data;
+
+    for (auto it = objects.constBegin(); it != objects.constEnd(); ++it) {
+        index.insert(it.key(), QJsonArray{ qint64(data.size()), qint64(it.value().size()) });
+        data.append(it.value());
+    }
+
+    QJsonObject header;
+    header.insert("meta",  QJsonObject::fromVariantMap(meta));
+    header.insert("index", index);
+
+    const QByteArray headerData = QJsonDocument(header).toJson(QJsonDocument::Compact);
+
+    // Write everything at once (file is replaced atomically)
+    QSaveFile file(fileName);
+    if (!file.open(QFile::WriteOnly)) { return false; }
+
+    file.write(magic);
+    file.write(QByteArray::number(headerData.size()) + '\n');
+    file.write(headerData);
+    file.write(data);
+
+    return file.commit();
+}
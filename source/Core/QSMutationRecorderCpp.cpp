@@ -0,0 +1,189 @@
+#include "QSMutationRecorderCpp.h"
+#include "QSObjectCpp.h"
+#include "QSRepositoryCpp.h"
+#include "QSSerializerCpp.h"
+#include "QSValueCodecs.h"
+
+#include <QDebug>
+#include <QJsonDocument>
+#include <QMetaProperty>
+
+const int QSMutationRecorderCpp::traceVersion = 1;
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+/*! Creates a (stopped) recorder for repo
+ * ************************************************************************************************/
+QSMutationRecorderCpp::QSMutationRecorderCpp(QSRepositoryCpp *repo)
+  : QObject         {repo}
+  , m_repo          (repo)
+  , m_file          ()
+  , m_timer         ()
+  , m_eventCount    (0)
+{
+    connect(m_repo, &QSRepositoryCpp::isLoadingChanged, this, &QSMutationRecorderCpp::onIsLoadingChanged);
+}
+
+/* ************************************************************************************************
+ * Public Getters
+ * ************************************************************************************************/
+bool QSMutationRecorderCpp::isRecording() const
+{
+    return m_file.isOpen();
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+/*! Records the addition of an object with its current properties
+ * ************************************************************************************************/
+void QSMutationRecorderCpp::recordAdded(const QString &uuidStr, QSObjectCpp *qsObject)
+{
+    // Sanity check
+    if (!isRecording() || qsObject == nullptr) { return; }
+
+    writeEvent(QStringLiteral("add"), QJsonObject {
+        { "id",     uuidStr },
+        { "props",  QJsonObject::fromVariantMap(QSSerializerCpp::getQSProps(qsObject)) }
+    });
+}
+
+/*! Records the deletion of an object
+ * ************************************************************************************************/
+void QSMutationRecorderCpp::recordDeleted(const QString &uuidStr)
+{
+    // Sanity check
+    if (!isRecording()) { return; }
+
+    writeEvent(QStringLiteral("delete"), QJsonObject { { "id", uuidStr } });
+}
+
+/*! Records the new value of a property (or all properties if propertyIndex is -1)
+ * ************************************************************************************************/
+void QSMutationRecorderCpp::recordChanged(QSObjectCpp *qsObject, int propertyIndex)
+{
+    // Sanity check
+    if (!isRecording() || qsObject == nullptr) { return; }
+
+    if (propertyIndex < 0) {
+        writeEvent(QStringLiteral("change"), QJsonObject {
+            { "id",     qsObject->getUuidStr() },
+            { "props",  QJsonObject::fromVariantMap(QSSerializerCpp::getQSProps(qsObject)) }
+        });
+        return;
+    }
+
+    const QMetaProperty metaProperty = qsObject->metaObject()->property(propertyIndex);
+
+    // Only stored properties are replayed
+    if (QSSerializerCpp::isPropertyBlackListed(metaProperty.name())) { return; }
+
+    const QVariant qsValue = metaProperty.isEnumType()
+                           ? QSValueCodecs::encodeEnum(metaProperty.enumerator(),
+                                                       metaProperty.read(qsObject).toInt())
+                           : QSSerializerCpp::getQSProp(metaProperty.read(qsObject));
+
+    writeEvent(QStringLiteral("change"), QJsonObject {
+        { "id",     qsObject->getUuidStr() },
+        { "prop",   QString::fromLatin1(metaProperty.name()) },
+        { "value",  QJsonValue::fromVariant(qsValue) }
+    });
+}
+
+/* ************************************************************************************************
+ * Public Slots
+ * ************************************************************************************************/
+/*! Starts recording into fileName (replacing it), beginning with the current state of the repo
+ * ************************************************************************************************/
+bool QSMutationRecorderCpp::start(const QString &fileName)
+{
+    stop();
+
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[QSMutationRecorder] Could not open trace file" << fileName
+                   << m_file.errorString();
+        return false;
+    }
+
+    QJsonObject objects;
+    for (auto it = m_repo->m_objects.cbegin(); it != m_repo->m_objects.cend(); ++it) {
+        if (const QSObjectCpp *qsObject = it.value().value<QSObjectCpp*>()) {
+            objects.insert(it.key(), QJsonObject::fromVariantMap(QSSerializerCpp::getQSProps(qsObject)));
+        }
+    }
+
+    writeLine(QJsonObject {
+        { "qsTrace",    traceVersion },
+        { "name",       m_repo->m_name },
+        { "root",       m_repo->m_rootObject != nullptr
+                        ? QSSerializerCpp::getQSUrl(m_repo->m_rootObject) : QString() },
+        { "objects",    objects }
+    });
+
+    m_eventCount = 0;
+    m_timer.start();
+
+    emit isRecordingChanged();
+
+    return true;
+}
+
+bool QSMutationRecorderCpp::start(const QUrl &fileUrl)
+{
+    return start(fileUrl.toLocalFile());
+}
+
+/*! Stops recording and closes the trace file
+ * ************************************************************************************************/
+void QSMutationRecorderCpp::stop()
+{
+    // Sanity check
+    if (!isRecording()) { return; }
+
+    m_file.close();
+
+    emit isRecordingChanged();
+}
+
+/*! Returns the number of mutations recorded since start()
+ * ************************************************************************************************/
+qint64 QSMutationRecorderCpp::getEventCount() const
+{
+    return m_eventCount;
+}
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+/*! Records the begin and end of loading (objects added while loading are recorded as usual)
+ * ************************************************************************************************/
+void QSMutationRecorderCpp::onIsLoadingChanged()
+{
+    // Sanity check
+    if (!isRecording()) { return; }
+
+    writeEvent(m_repo->m_isLoading ? QStringLiteral("beginLoad") : QStringLiteral("endLoad"),
+               QJsonObject());
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+void QSMutationRecorderCpp::writeLine(const QJsonObject &line)
+{
+    m_file.write(QJsonDocument(line).toJson(QJsonDocument::Compact));
+    m_file.write("\n", 1);
+}
+
+/*! Writes a mutation, stamped with the time since start() in microseconds
+ * ************************************************************************************************/
+void QSMutationRecorderCpp::writeEvent(const QString &op, QJsonObject &&event)
+{
+    event.insert(QStringLiteral("t"),  m_timer.nsecsElapsed() / 1000);
+    event.insert(QStringLiteral("op"), op);
+
+    writeLine(event);
+    ++m_eventCount;
+}
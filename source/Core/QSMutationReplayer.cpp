@@ -0,0 +1,356 @@
+#include "QSMutationReplayer.h"
+#include "QSMutationRecorderCpp.h"
+#include "QSObjectCpp.h"
+#include "QSObjectListCpp.h"
+#include "QSRepositoryCpp.h"
+#include "QSSerializerCpp.h"
+#include "QSValueCodecs.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonDocument>
+#include <QMetaProperty>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+//! Returns the nearest-rank percentile of sorted samples
+qint64 percentile(const QList<qint64> &sortedSamples, double p)
+{
+    if (sortedSamples.isEmpty()) { return 0; }
+
+    const qsizetype rank = qsizetype(std::ceil(p / 100.0 * sortedSamples.size()));
+
+    return sortedSamples.at(std::clamp<qsizetype>(rank - 1, 0, sortedSamples.size() - 1));
+}
+
+} // namespace
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+QSMutationReplayer::QSMutationReplayer()
+  : m_name          ()
+  , m_rootId        ()
+  , m_objects       ()
+  , m_events        ()
+  , m_factory       (&QSMutationReplayer::createObject)
+{
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+/*! Reads a trace written by QSMutationRecorderCpp
+ * ************************************************************************************************/
+bool QSMutationReplayer::load(const QString &fileName, QString *errorString)
+{
+    const auto fail = [errorString](const QString &error) {
+        if (errorString != nullptr) { *errorString = error; }
+        return false;
+    };
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return fail(QStringLiteral("Could not open %1: %2").arg(fileName, file.errorString()));
+    }
+
+    m_events.clear();
+
+    // Header: the repo when recording started
+    QJsonParseError   parseError;
+    const QJsonObject header = QJsonDocument::fromJson(file.readLine(), &parseError).object();
+
+    if (parseError.error != QJsonParseError::NoError || !header.contains(QLatin1String("qsTrace"))) {
+        return fail(QStringLiteral("%1 is not a mutation trace").arg(fileName));
+    }
+    if (header.value(QLatin1String("qsTrace")).toInt() > QSMutationRecorderCpp::traceVersion) {
+        return fail(QStringLiteral("Unsupported trace version %1")
+                        .arg(header.value(QLatin1String("qsTrace")).toInt()));
+    }
+
+    m_name    = header.value(QLatin1String("name")).toString();
+    m_rootId  = header.value(QLatin1String("root")).toString().mid(QSSerializerCpp::protoString.size());
+    m_objects = header.value(QLatin1String("objects")).toObject().toVariantMap();
+
+    // Mutations, one per line
+    for (int lineNumber = 2; !file.atEnd(); ++lineNumber) {
+        const QByteArray line = file.readLine().trimmed();
+        if (line.isEmpty()) { continue; }
+
+        const QJsonObject json = QJsonDocument::fromJson(line, &parseError).object();
+        if (parseError.error != QJsonParseError::NoError) {
+            return fail(QStringLiteral("Line %1: %2").arg(lineNumber).arg(parseError.errorString()));
+        }
+
+        Event event;
+        event.op       = json.value(QLatin1String("op")).toString();
+        event.uuidStr  = json.value(QLatin1String("id")).toString();
+        event.propName = json.value(QLatin1String("prop")).toString();
+        event.value    = json.contains(QLatin1String("props"))
+                       ? json.value(QLatin1String("props")).toVariant()
+                       : json.value(QLatin1String("value")).toVariant();
+
+        m_events.append(event);
+    }
+
+    return true;
+}
+
+void QSMutationReplayer::setFactory(const Factory &factory)
+{
+    m_factory = factory ? factory : Factory(&QSMutationReplayer::createObject);
+}
+
+qsizetype QSMutationReplayer::eventCount() const
+{
+    return m_events.size();
+}
+
+/*! Restores the recorded initial state into repo (not timed) and replays all mutations. Created
+ *  objects are children of repo.
+ * ************************************************************************************************/
+QVariantMap QSMutationReplayer::replay(QSRepositoryCpp *repo)
+{
+    // Sanity check
+    if (repo == nullptr) { return QVariantMap(); }
+
+    // Initial state: create all objects first, so references can be resolved
+    repo->setProperty("_isLoading", true);
+    repo->setProperty("name", m_name);
+
+    QList<QPair<QSObjectCpp*, QVariantMap>> initialObjects;
+    initialObjects.reserve(m_objects.size());
+    for (auto it = m_objects.cbegin(); it != m_objects.cend(); ++it) {
+        const QVariantMap qsProps = it.value().toMap();
+        QSObjectCpp *qsObject = addObject(repo, it.key(), qsProps);
+
+        repo->addObject(it.key(), qsObject);
+        initialObjects.append({ qsObject, qsProps });
+    }
+    for (const auto &[qsObject, qsProps] : std::as_const(initialObjects)) {
+        for (auto it = qsProps.cbegin(); it != qsProps.cend(); ++it) {
+            if (it.key() == QLatin1String("qsType")) { continue; }
+            writeProperty(repo, qsObject, it.key(), resolveValue(repo, it.value()));
+        }
+    }
+
+    repo->setProperty("qsRootObject", QVariant::fromValue(repo->getObject(m_rootId)));
+    repo->setProperty("_isLoading", false);
+    repo->updateReferences(m_objects.keys());
+
+    // Mutations
+    QHash<QString, QList<qint64>> samplesByOp;
+    qint64                        operations = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (const Event &event : std::as_const(m_events)) {
+        const qint64 nsecs = applyEvent(repo, event);
+        if (nsecs < 0) { continue; }
+
+        samplesByOp[event.op].append(nsecs);
+        ++operations;
+    }
+
+    const qint64 elapsedNsecs = timer.nsecsElapsed();
+
+    // Report
+    QVariantMap kinds;
+    for (auto it = samplesByOp.begin(); it != samplesByOp.end(); ++it) {
+        QList<qint64> &samples = it.value();
+        std::sort(samples.begin(), samples.end());
+
+        qint64 totalNsecs = 0;
+        for (qint64 nsecs : std::as_const(samples)) { totalNsecs += nsecs; }
+
+        kinds.insert(it.key(), QVariantMap {
+            { "count",          samples.size() },
+            { "opsPerSecond",   totalNsecs > 0 ? samples.size() * 1e9 / totalNsecs : 0.0 },
+            { "meanUs",         totalNsecs / 1000.0 / samples.size() },
+            { "p50Us",          percentile(samples, 50) / 1000.0 },
+            { "p90Us",          percentile(samples, 90) / 1000.0 },
+            { "p99Us",          percentile(samples, 99) / 1000.0 },
+            { "maxUs",          samples.last() / 1000.0 }
+        });
+    }
+
+    return {
+        { "operations",     operations },
+        { "skipped",        m_events.size() - operations },
+        { "elapsedMs",      elapsedNsecs / 1e6 },
+        { "opsPerSecond",   elapsedNsecs > 0 ? operations * 1e9 / elapsedNsecs : 0.0 },
+        { "kinds",          kinds }
+    };
+}
+
+/* ************************************************************************************************
+ * Public Static Functions
+ * ************************************************************************************************/
+/*! Default factory: creates C++ types (registered meta type with a Q_INVOKABLE constructor), or a
+ *  plain QSObjectCpp for all other types
+ * ************************************************************************************************/
+QSObjectCpp *QSMutationReplayer::createObject(const QString &qsType)
+{
+    const QMetaType   metaType   = QMetaType::fromName(qsType.toLatin1() + '*');
+    const QMetaObject *metaObject = metaType.metaObject();
+
+    if (metaObject != nullptr && metaObject->inherits(&QSObjectCpp::staticMetaObject)) {
+        if (QObject *object = metaObject->newInstance()) {
+            return static_cast<QSObjectCpp*>(object);
+        }
+    }
+
+    QSObjectCpp *qsObject = new QSObjectCpp();
+    qsObject->setObjectName(qsType);
+
+    return qsObject;
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+/*! Creates the object of qsProps with the given UUID (not registered with repo yet)
+ * ************************************************************************************************/
+QSObjectCpp *QSMutationReplayer::addObject(QSRepositoryCpp *repo, const QString &uuidStr,
+                                           const QVariantMap &qsProps)
+{
+    QSObjectCpp *qsObject = m_factory(qsProps.value(QStringLiteral("qsType")).toString());
+
+    // UUID first, it cannot be changed once the object belongs to repo
+    qsObject->setProperty("_qsUuid", uuidStr);
+    qsObject->setParent(repo);
+
+    return qsObject;
+}
+
+/*! Applies a single mutation, returns the time spent in the repo (ns) or -1 if it was skipped
+ * ************************************************************************************************/
+qint64 QSMutationReplayer::applyEvent(QSRepositoryCpp *repo, const Event &event)
+{
+    QElapsedTimer timer;
+
+    if (event.op == QLatin1String("add")) {
+        const QVariantMap qsProps  = event.value.toMap();
+        QSObjectCpp      *qsObject = addObject(repo, event.uuidStr, qsProps);
+
+        for (auto it = qsProps.cbegin(); it != qsProps.cend(); ++it) {
+            if (it.key() == QLatin1String("qsType")) { continue; }
+            writeProperty(repo, qsObject, it.key(), resolveValue(repo, it.value()));
+        }
+
+        timer.start();
+        repo->addObject(event.uuidStr, qsObject);
+        return timer.nsecsElapsed();
+    }
+
+    if (event.op == QLatin1String("delete")) {
+        QSObjectCpp *qsObject = repo->getObject(event.uuidStr);
+        if (qsObject == nullptr) { return -1; }
+
+        timer.start();
+        repo->delObject(event.uuidStr);
+        const qint64 nsecs = timer.nsecsElapsed();
+
+        if (qsObject->parent() == repo) { delete qsObject; }
+        return nsecs;
+    }
+
+    if (event.op == QLatin1String("change")) {
+        QSObjectCpp *qsObject = repo->getObject(event.uuidStr);
+        if (qsObject == nullptr) { return -1; }
+
+        // Single property
+        if (!event.propName.isEmpty()) {
+            const QVariant value = resolveValue(repo, event.value);
+
+            timer.start();
+            writeProperty(repo, qsObject, event.propName, value);
+            return timer.nsecsElapsed();
+        }
+
+        // All properties
+        const QVariantMap values = resolveValue(repo, event.value).toMap();
+
+        timer.start();
+        for (auto it = values.cbegin(); it != values.cend(); ++it) {
+            if (it.key() == QLatin1String("qsType")) { continue; }
+            writeProperty(repo, qsObject, it.key(), it.value());
+        }
+        return timer.nsecsElapsed();
+    }
+
+    if (event.op == QLatin1String("beginLoad") || event.op == QLatin1String("endLoad")) {
+        timer.start();
+        repo->setProperty("_isLoading", event.op == QLatin1String("beginLoad"));
+        return timer.nsecsElapsed();
+    }
+
+    return -1;
+}
+
+/*! Turns a stored value back into a property value: references are resolved in repo and tagged
+ *  values are decoded
+ * ************************************************************************************************/
+QVariant QSMutationReplayer::resolveValue(QSRepositoryCpp *repo, const QVariant &qsValue)
+{
+    switch (qsValue.typeId()) {
+    case QMetaType::QString: {
+        const QString str = qsValue.toString();
+        if (!str.startsWith(QSSerializerCpp::protoString)) { return qsValue; }
+
+        return QVariant::fromValue(repo->getObject(str.mid(QSSerializerCpp::protoString.size())));
+    }
+    case QMetaType::QVariantList: {
+        QVariantList values = qsValue.toList();
+        for (QVariant &value : values) {
+            value = resolveValue(repo, value);
+        }
+        return values;
+    }
+    case QMetaType::QVariantMap: {
+        QVariantMap values = qsValue.toMap();
+        if (QSValueCodecs::isEncoded(values)) { return QSValueCodecs::decode(values); }
+
+        for (QVariant &value : values) {
+            value = resolveValue(repo, value);
+        }
+        return values;
+    }
+    default:
+        return qsValue;
+    }
+}
+
+/*! Writes a property: object lists are filled in place, properties missing on the object are added
+ *  as dynamic properties and reported to repo, as they have no change signal. Returns whether a
+ *  declared property was written.
+ * ************************************************************************************************/
+bool QSMutationReplayer::writeProperty(QSRepositoryCpp *repo, QSObjectCpp *qsObject,
+                                       const QString &propName, const QVariant &value)
+{
+    const QByteArray  name          = propName.toLatin1();
+    const int         propertyIndex = qsObject->metaObject()->indexOfProperty(name.constData());
+
+    if (propertyIndex >= 0) {
+        const QMetaProperty metaProperty = qsObject->metaObject()->property(propertyIndex);
+
+        if (QSObjectListCpp *qsList = qobject_cast<QSObjectListCpp*>(
+                    metaProperty.read(qsObject).value<QObject*>())) {
+            qsList->setElements(value.toList());
+            return true;
+        }
+
+        if (metaProperty.write(qsObject, value)) { return true; }
+    } else {
+        qsObject->setProperty(name.constData(), value);
+    }
+
+    repo->notifyObjectChanged(qsObject, propName);
+
+    return false;
+}
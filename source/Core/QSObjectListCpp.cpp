@@ -0,0 +1,477 @@
+#include "QSObjectListCpp.h"
+#include "QSObjectCpp.h"
+#include "QSRepositoryCpp.h"
+
+#include <QDebug>
+#include <QSet>
+
+#include <algorithm>
+#include <utility>
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+/*! Default constructor
+ * ************************************************************************************************/
+QSObjectListCpp::QSObjectListCpp(QObject *parent)
+  : QAbstractListModel  {parent}
+  , m_owner             ()
+  , m_elements          ()
+  , m_elementsByUuid    ()
+  , m_uuidsByElement    ()
+{
+}
+
+/* ************************************************************************************************
+ * Public Getters & Setters
+ * ************************************************************************************************/
+/*! Returns the owner of the elements (the parent if no owner is set)
+ * ************************************************************************************************/
+QSObjectCpp *QSObjectListCpp::getOwner() const
+{
+    return ownerObject();
+}
+
+int QSObjectListCpp::count() const
+{
+    return int(m_elements.size());
+}
+
+/*! Returns the elements in order
+ * ************************************************************************************************/
+QVariantList QSObjectListCpp::getElements() const
+{
+    QVariantList elements;
+    elements.reserve(m_elements.size());
+
+    for (QSObjectCpp *element : m_elements) {
+        elements.append(QVariant::fromValue(element));
+    }
+
+    return elements;
+}
+
+/*! Allows QML/JS to distinguish object lists from other QObjects
+ * ************************************************************************************************/
+bool QSObjectListCpp::isObjectList() const
+{
+    return true;
+}
+
+/*! Sets the owner, elements already added keep their repo and parent
+ * ************************************************************************************************/
+void QSObjectListCpp::setOwner(QSObjectCpp *owner)
+{
+    // Sanity check
+    if (m_owner == owner) { return; }
+
+    m_owner = owner;
+    emit ownerChanged();
+}
+
+/* ************************************************************************************************
+ * Public Functions (QAbstractListModel)
+ * ************************************************************************************************/
+int QSObjectListCpp::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : count();
+}
+
+QVariant QSObjectListCpp::data(const QModelIndex &index, int role) const
+{
+    // Sanity check
+    if (!index.isValid() || index.row() >= m_elements.size()) { return QVariant(); }
+
+    QSObjectCpp *element = m_elements.at(index.row());
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case QSObjectRole:
+        return QVariant::fromValue(element);
+    case QSUuidRole:
+        return element->getUuidStr();
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> QSObjectListCpp::roleNames() const
+{
+    return {
+        { QSObjectRole, "qsObject" },
+        { QSUuidRole,   "qsUuid"   }
+    };
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+const QList<QSObjectCpp*> &QSObjectListCpp::elements() const
+{
+    return m_elements;
+}
+
+/*! Removes the element without detaching it from repo and parent, used by the repo when it deletes
+ *  the element itself (see QSSerializerCpp::removeReference())
+ * ************************************************************************************************/
+bool QSObjectListCpp::removeReference(const QObject *element)
+{
+    for (qsizetype i = 0; i < m_elements.size(); ++i) {
+        if (m_elements.at(i) == element) {
+            const int oldCount = count();
+            takeAt(int(i), false);
+            notifyChanged(oldCount);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* ************************************************************************************************
+ * Public Slots
+ * ************************************************************************************************/
+bool QSObjectListCpp::append(QSObjectCpp *element)
+{
+    return insert(count(), element);
+}
+
+/*! Inserts the element at index, the element is assigned to the repo of the owner and parented to
+ *  the owner -- mirrors QSObject.addElement()
+ * ************************************************************************************************/
+bool QSObjectListCpp::insert(int index, QSObjectCpp *element)
+{
+    // Sanity check
+    if (element == nullptr || contains(element)) { return false; }
+
+    const int oldCount = count();
+    index = qBound(0, index, oldCount);
+
+    beginInsertRows(QModelIndex(), index, index);
+    m_elements.insert(index, element);
+    attach(element);
+    endInsertRows();
+
+    notifyChanged(oldCount);
+
+    return true;
+}
+
+/*! Removes the element, the element is detached from repo and parent -- mirrors
+ *  QSObject.removeElement()
+ * ************************************************************************************************/
+bool QSObjectListCpp::remove(QSObjectCpp *element)
+{
+    // Sanity check
+    if (!contains(element)) {
+        qWarning() << "[QSObjectList] Attempted to remove unknown element:"
+                   << (element != nullptr ? element->getUuidStr() : QString());
+        return false;
+    }
+
+    return removeAt(indexOf(element));
+}
+
+bool QSObjectListCpp::removeAt(int index)
+{
+    const int oldCount = count();
+
+    if (!takeAt(index, true)) { return false; }
+
+    notifyChanged(oldCount);
+
+    return true;
+}
+
+/*! Moves the element at from to index to (the element keeps its repo and parent)
+ * ************************************************************************************************/
+bool QSObjectListCpp::move(int from, int to)
+{
+    // Sanity check
+    if (from < 0 || from >= count() || to < 0 || to >= count()) { return false; }
+    if (from == to) { return true; }
+
+    // Destination row is the row before which the element is inserted (before it is removed)
+    beginMoveRows(QModelIndex(), from, from, QModelIndex(), to > from ? to + 1 : to);
+    m_elements.move(from, to);
+    endMoveRows();
+
+    notifyChanged(count());
+
+    return true;
+}
+
+/*! Removes all elements
+ * ************************************************************************************************/
+void QSObjectListCpp::clear()
+{
+    // Sanity check
+    if (m_elements.isEmpty()) { return; }
+
+    const int oldCount = count();
+
+    beginRemoveRows(QModelIndex(), 0, oldCount - 1);
+    const QList<QSObjectCpp*> elements = std::exchange(m_elements, {});
+    for (QSObjectCpp *element : elements) {
+        detach(element, true);
+    }
+    endRemoveRows();
+
+    notifyChanged(oldCount);
+}
+
+/*! Adds/removes/moves elements to match elements (QSObjects, duplicates and other values are
+ *  skipped). Only rows that changed are signaled: removals and insertions are grouped in runs of
+ *  consecutive rows, and elements already in the list are moved.
+ *
+ *  Each row change is linear (it shifts the rows behind it), so larger changes (more than
+ *  maxRowChanges runs and moves) are signaled as model reset instead, keeping the update linear.
+ * ************************************************************************************************/
+void QSObjectListCpp::setElements(const QVariantList &elements)
+{
+    QList<QSObjectCpp*> newElements;
+    QSet<QSObjectCpp*>  newElementSet;
+
+    newElements.reserve(elements.size());
+    newElementSet.reserve(elements.size());
+
+    for (const QVariant &elementVar : elements) {
+        QSObjectCpp *element = qobject_cast<QSObjectCpp*>(elementVar.value<QObject*>());
+
+        if (element != nullptr && !newElementSet.contains(element)) {
+            newElements.append(element);
+            newElementSet.insert(element);
+        }
+    }
+
+    // Sanity check
+    if (newElements == m_elements) { return; }
+
+    const int oldCount = count();
+
+    // Each row change shifts the rows behind it, so the number of changes signaled is limited
+    constexpr int maxRowChanges = 32;
+
+    int rowChanges = 0;
+
+    // Remove elements that are not in the new list (in runs of consecutive rows, back to front)
+    for (int last = count() - 1; last >= 0 && rowChanges <= maxRowChanges; ) {
+        if (newElementSet.contains(m_elements.at(last))) { --last; continue; }
+
+        if (++rowChanges > maxRowChanges) { break; }
+
+        int first = last;
+        while (first > 0 && !newElementSet.contains(m_elements.at(first - 1))) { --first; }
+
+        beginRemoveRows(QModelIndex(), first, last);
+        for (int i = last; i >= first; --i) {
+            detach(m_elements.takeAt(i), true);
+        }
+        endRemoveRows();
+
+        last = first - 1;
+    }
+
+    // Remaining elements are a subset of the new ones: move them in place, insert the new ones
+    for (int i = 0; i < newElements.size() && rowChanges <= maxRowChanges; ) {
+        QSObjectCpp *element = newElements.at(i);
+
+        if (i < m_elements.size() && m_elements.at(i) == element) { ++i; continue; }
+
+        if (++rowChanges > maxRowChanges) { break; }
+
+        if (contains(element)) {
+            const int from = int(m_elements.indexOf(element, i));
+
+            beginMoveRows(QModelIndex(), from, from, QModelIndex(), i);
+            m_elements.move(from, i);
+            endMoveRows();
+
+            ++i;
+            continue;
+        }
+
+        int last = i;
+        while (last + 1 < newElements.size() && !contains(newElements.at(last + 1))) { ++last; }
+
+        beginInsertRows(QModelIndex(), i, last);
+        for (int j = i; j <= last; ++j) {
+            m_elements.insert(j, newElements.at(j));
+            attach(newElements.at(j));
+        }
+        endInsertRows();
+
+        i = last + 1;
+    }
+
+    // Too many changes: signal the remaining ones as model reset
+    if (rowChanges > maxRowChanges) {
+        beginResetModel();
+        for (QSObjectCpp *element : std::as_const(m_elements)) {
+            if (!newElementSet.contains(element)) { detach(element, true); }
+        }
+        for (QSObjectCpp *element : std::as_const(newElements)) {
+            if (!contains(element)) { attach(element); }
+        }
+        m_elements = std::move(newElements);
+        endResetModel();
+    }
+
+    notifyChanged(oldCount);
+}
+
+/*! Returns whether the element is in the list (constant time)
+ * ************************************************************************************************/
+bool QSObjectListCpp::contains(QSObjectCpp *element) const
+{
+    return element != nullptr && m_elementsByUuid.value(element->getUuidStr()) == element;
+}
+
+int QSObjectListCpp::indexOf(QSObjectCpp *element) const
+{
+    return contains(element) ? int(m_elements.indexOf(element)) : -1;
+}
+
+QSObjectCpp *QSObjectListCpp::get(int index) const
+{
+    return m_elements.value(index, nullptr);
+}
+
+QSObjectCpp *QSObjectListCpp::getByUuid(const QString &uuidStr) const
+{
+    return m_elementsByUuid.value(uuidStr, nullptr);
+}
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+/*! Removes destroyed elements (without accessing them)
+ * ************************************************************************************************/
+void QSObjectListCpp::onElementDestroyed(QObject *object)
+{
+    const auto uuidIt = m_uuidsByElement.constFind(object);
+
+    // Sanity check
+    if (uuidIt == m_uuidsByElement.cend()) { return; }
+
+    const int index    = int(m_elements.indexOf(m_elementsByUuid.value(uuidIt.value())));
+    const int oldCount = count();
+
+    beginRemoveRows(QModelIndex(), index, index);
+    m_elements.removeAt(index);
+    m_elementsByUuid.remove(uuidIt.value());
+    m_uuidsByElement.erase(uuidIt);
+    endRemoveRows();
+
+    notifyChanged(oldCount);
+}
+
+/*! Re-keys the element by its new UUID
+ * ************************************************************************************************/
+void QSObjectListCpp::onElementUuidChanged()
+{
+    QSObjectCpp *element = qobject_cast<QSObjectCpp*>(sender());
+
+    // Sanity check
+    if (element == nullptr || !m_uuidsByElement.contains(element)) { return; }
+
+    m_elementsByUuid.remove(m_uuidsByElement.value(element));
+    m_elementsByUuid.insert(element->getUuidStr(), element);
+    m_uuidsByElement.insert(element, element->getUuidStr());
+}
+
+/*! Drops the children of a destroyed owner at once (it is about to destroy them), so they are not
+ *  removed one by one
+ * ************************************************************************************************/
+void QSObjectListCpp::onOwnerDestroyed(QObject *owner)
+{
+    const auto isChild = [owner](const QSObjectCpp *element) { return element->parent() == owner; };
+
+    // Sanity check
+    if (std::none_of(m_elements.cbegin(), m_elements.cend(), isChild)) { return; }
+
+    const int oldCount = count();
+
+    beginResetModel();
+    m_elements.removeIf([this, &isChild](QSObjectCpp *element) {
+        if (!isChild(element)) { return false; }
+
+        detach(element, false);
+        return true;
+    });
+    endResetModel();
+
+    if (oldCount != count()) { emit countChanged(); }
+    emit elementsChanged();
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+/*! Returns the owner, or the parent if it is a QSObject
+ * ************************************************************************************************/
+QSObjectCpp *QSObjectListCpp::ownerObject() const
+{
+    return m_owner != nullptr ? m_owner.data() : qobject_cast<QSObjectCpp*>(parent());
+}
+
+/*! Indexes the element, and assigns the repo and parent of the owner
+ * ************************************************************************************************/
+void QSObjectListCpp::attach(QSObjectCpp *element)
+{
+    m_elementsByUuid.insert(element->getUuidStr(), element);
+    m_uuidsByElement.insert(element, element->getUuidStr());
+
+    connect(element, &QObject::destroyed,         this, &QSObjectListCpp::onElementDestroyed);
+    connect(element, &QSObjectCpp::uuidChanged,   this, &QSObjectListCpp::onElementUuidChanged);
+
+    if (QSObjectCpp *owner = ownerObject()) {
+        connect(owner, &QObject::destroyed, this, &QSObjectListCpp::onOwnerDestroyed,
+                Qt::UniqueConnection);
+
+        element->setRepo(owner->getRepo());
+        element->setParent(owner);
+    }
+}
+
+/*! Unindexes and stops observing the element, and detaches it from repo and parent if release is
+ *  set
+ * ************************************************************************************************/
+void QSObjectListCpp::detach(QSObjectCpp *element, bool release)
+{
+    m_elementsByUuid.remove(m_uuidsByElement.take(element));
+    disconnect(element, nullptr, this, nullptr);
+
+    if (release) {
+        element->setRepo(nullptr);
+        element->setParent(nullptr);
+    }
+}
+
+/*! Removes the element at index (see detach())
+ * ************************************************************************************************/
+bool QSObjectListCpp::takeAt(int index, bool release)
+{
+    // Sanity check
+    if (index < 0 || index >= count()) { return false; }
+
+    beginRemoveRows(QModelIndex(), index, index);
+    detach(m_elements.takeAt(index), release);
+    endRemoveRows();
+
+    return true;
+}
+
+/*! Informs observers and the repo of the owner about changed elements
+ * ************************************************************************************************/
+void QSObjectListCpp::notifyChanged(int oldCount)
+{
+    if (oldCount != count()) { emit countChanged(); }
+    emit elementsChanged();
+
+    if (QSObjectCpp *owner = ownerObject()) {
+        if (QSRepositoryCpp *repo = owner->getRepo()) {
+            repo->notifyObjectChanged(owner);
+        }
+    }
+}
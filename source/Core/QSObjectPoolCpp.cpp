@@ -0,0 +1,292 @@
+#include "QSObjectPoolCpp.h"
+#include "QSObjectCpp.h"
+#include "QSRepositoryCpp.h"
+#include "QSSerializerCpp.h"
+#include "QSUndoHistoryCpp.h"
+
+#include <QDebug>
+#include <QMetaProperty>
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+/*! Creates a (disabled) pool for repo
+ * ************************************************************************************************/
+QSObjectPoolCpp::QSObjectPoolCpp(QSRepositoryCpp *repo)
+  : QObject         {repo}
+  , m_repo          (repo)
+  , m_enabled       (false)
+  , m_maxPerType    (4096)
+  , m_maxTotal      (65536)
+  , m_size          (0)
+  , m_hits          (0)
+  , m_misses        (0)
+  , m_defaults      ()
+  , m_parked        ()
+{
+}
+
+/* ************************************************************************************************
+ * Public Getters & Setters
+ * ************************************************************************************************/
+bool QSObjectPoolCpp::isEnabled() const
+{
+    return m_enabled;
+}
+
+int QSObjectPoolCpp::getMaxPerType() const
+{
+    return m_maxPerType;
+}
+
+int QSObjectPoolCpp::getMaxTotal() const
+{
+    return m_maxTotal;
+}
+
+/*! Returns the number of parked objects
+ * ************************************************************************************************/
+int QSObjectPoolCpp::size() const
+{
+    return m_size;
+}
+
+/*! Returns how often acquire() could reuse an object
+ * ************************************************************************************************/
+int QSObjectPoolCpp::getHits() const
+{
+    return m_hits;
+}
+
+int QSObjectPoolCpp::getMisses() const
+{
+    return m_misses;
+}
+
+/*! Enables/disables pooling, disabling destroys all parked objects
+ * ************************************************************************************************/
+void QSObjectPoolCpp::setEnabled(bool enabled)
+{
+    // Sanity check
+    if (m_enabled == enabled) { return; }
+
+    m_enabled = enabled;
+
+    if (!m_enabled) { clear(); }
+
+    emit enabledChanged();
+}
+
+void QSObjectPoolCpp::setMaxPerType(int maxPerType)
+{
+    // Sanity check
+    if (m_maxPerType == maxPerType || maxPerType < 0) { return; }
+
+    m_maxPerType = maxPerType;
+    trimToLimits();
+
+    emit limitsChanged();
+}
+
+void QSObjectPoolCpp::setMaxTotal(int maxTotal)
+{
+    // Sanity check
+    if (m_maxTotal == maxTotal || maxTotal < 0) { return; }
+
+    m_maxTotal = maxTotal;
+    trimToLimits();
+
+    emit limitsChanged();
+}
+
+/* ************************************************************************************************
+ * Public Slots
+ * ************************************************************************************************/
+/*! Stores the serialized properties of a freshly created object as defaults of its qsType (once)
+ * ************************************************************************************************/
+void QSObjectPoolCpp::captureDefaults(QSObjectCpp *qsObject)
+{
+    // Sanity check
+    if (qsObject == nullptr || m_defaults.contains(qsObject->getType())) { return; }
+
+    QHash<int, QVariant> &defaults = m_defaults[qsObject->getType()];
+
+    const QMetaObject *metaObject = qsObject->metaObject();
+    for (int i = 0; i < metaObject->propertyCount(); ++i) {
+        const QMetaProperty metaProperty = metaObject->property(i);
+
+        if (!metaProperty.isWritable()
+                || QSSerializerCpp::isPropertyBlackListed(metaProperty.name())) {
+            continue;
+        }
+
+        const QVariant value = QSSerializerCpp::toPlainValue(metaProperty.read(qsObject));
+
+        // Objects owned by the instance cannot be shared as defaults
+        if (value.metaType().flags().testFlag(QMetaType::PointerToQObject)
+                && value.value<QObject*>() != nullptr) {
+            continue;
+        }
+
+        defaults.insert(i, value);
+    }
+}
+
+/*! Parks an object that was removed from the repository. Returns false if the object was not
+ *  pooled (disabled, no defaults, pool full, or still in use), it should be destroyed by the caller
+ *  then.
+ *
+ *  Objects referenced by other objects or by the undo history are still in use: reusing them for
+ *  another UUID would make these references point to the wrong object.
+ * ************************************************************************************************/
+bool QSObjectPoolCpp::recycle(QSObjectCpp *qsObject)
+{
+    // Sanity check
+    if (!m_enabled || qsObject == nullptr || qsObject == m_repo->m_rootObject) { return false; }
+    if (m_repo->isReferenced(qsObject->getUuidStr()))                          { return false; }
+    if (m_repo->m_undoHistory->holdsObject(qsObject))                          { return false; }
+
+    const QString qsType = qsObject->getType();
+
+    const auto defaultsIt = m_defaults.constFind(qsType);
+    if (defaultsIt == m_defaults.constEnd()) { return false; }
+
+    QList<QPointer<QSObjectCpp>> &parked = m_parked[qsType];
+    if (parked.size() >= m_maxPerType || m_size >= m_maxTotal) { return false; }
+
+    // Remove from repo (if still registered)
+    if (m_repo->getObject(qsObject->getUuidStr()) == qsObject) {
+        m_repo->delObject(qsObject->getUuidStr());
+    }
+    qsObject->setRepo(nullptr);
+
+    // Drop references, the objects may be deleted before this one is reused (values are kept)
+    const QMetaObject *metaObject = qsObject->metaObject();
+    for (auto it = defaultsIt->cbegin(); it != defaultsIt->cend(); ++it) {
+        const QMetaProperty metaProperty = metaObject->property(it.key());
+
+        if (metaProperty.metaType().flags().testFlag(QMetaType::PointerToQObject)) {
+            metaProperty.write(qsObject, it.value());
+        }
+    }
+
+    parked.append(qsObject);
+    ++m_size;
+
+    emit sizeChanged();
+
+    return true;
+}
+
+/*! Returns a parked object of qsType (unregistered) or nullptr. qsProps are the properties the
+ *  caller is about to write, all other serialized properties are reset to their defaults.
+ * ************************************************************************************************/
+QSObjectCpp *QSObjectPoolCpp::acquire(const QString &qsType, const QVariantMap &qsProps)
+{
+    // Sanity check
+    if (!m_enabled) { return nullptr; }
+
+    auto parkedIt = m_parked.find(qsType);
+
+    while (parkedIt != m_parked.end() && !parkedIt->isEmpty()) {
+        // Objects are only taken when they can be reset
+        if (!parkedIt->constLast().isNull() && !resetMissing(parkedIt->constLast(), qsProps)) {
+            break;
+        }
+
+        QPointer<QSObjectCpp> qsObject = parkedIt->takeLast();
+        --m_size;
+
+        // Skip objects destroyed in the meantime
+        if (qsObject.isNull()) { continue; }
+
+        ++m_hits;
+        emit sizeChanged();
+
+        return qsObject.data();
+    }
+
+    ++m_misses;
+    emit sizeChanged();
+
+    return nullptr;
+}
+
+int QSObjectPoolCpp::countByType(const QString &qsType) const
+{
+    return m_parked.value(qsType).size();
+}
+
+/*! Destroys all parked objects
+ * ************************************************************************************************/
+void QSObjectPoolCpp::clear()
+{
+    for (const QList<QPointer<QSObjectCpp>> &parked : std::as_const(m_parked)) {
+        for (const QPointer<QSObjectCpp> &qsObject : parked) {
+            if (!qsObject.isNull()) { qsObject->deleteLater(); }
+        }
+    }
+
+    m_parked.clear();
+    m_size = 0;
+
+    emit sizeChanged();
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+/*! Destroys the oldest parked objects until the pool fits its limits
+ * ************************************************************************************************/
+void QSObjectPoolCpp::trimToLimits()
+{
+    const int oldSize = m_size;
+
+    for (QList<QPointer<QSObjectCpp>> &parked : m_parked) {
+        while (!parked.isEmpty() && (parked.size() > m_maxPerType || m_size > m_maxTotal)) {
+            QPointer<QSObjectCpp> qsObject = parked.takeFirst();
+            --m_size;
+
+            if (!qsObject.isNull()) { qsObject->deleteLater(); }
+        }
+    }
+
+    if (m_size != oldSize) { emit sizeChanged(); }
+}
+
+/*! Resets the serialized properties of qsObject that are missing in qsProps to their defaults.
+ *  Returns false for QML types with missing properties, as their defaults may be bindings.
+ * ************************************************************************************************/
+bool QSObjectPoolCpp::resetMissing(QSObjectCpp *qsObject, const QVariantMap &qsProps) const
+{
+    const QHash<int, QVariant> defaults   = m_defaults.value(qsObject->getType());
+    const QMetaObject         *metaObject = qsObject->metaObject();
+
+    QList<QMetaProperty> missingProperties;
+    for (auto it = defaults.cbegin(); it != defaults.cend(); ++it) {
+        const QMetaProperty metaProperty = metaObject->property(it.key());
+
+        if (!qsProps.contains(QString::fromLatin1(metaProperty.name()))) {
+            missingProperties.append(metaProperty);
+        }
+    }
+
+    // Sanity check
+    if (missingProperties.isEmpty())  { return true; }
+    if (!isNativeType(metaObject))    { return false; }
+
+    for (const QMetaProperty &metaProperty : std::as_const(missingProperties)) {
+        metaProperty.write(qsObject, defaults.value(metaProperty.propertyIndex()));
+    }
+
+    return true;
+}
+
+/*! Returns whether the type is a C++ type (types declared in QML get a generated meta object)
+ * ************************************************************************************************/
+bool QSObjectPoolCpp::isNativeType(const QMetaObject *metaObject)
+{
+    const QByteArray className(metaObject->className());
+
+    return !className.contains("_QMLTYPE_") && !className.contains("_QML_");
+}
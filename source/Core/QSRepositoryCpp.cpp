@@ -1,8 +1,98 @@
 #include "QSRepositoryCpp.h"
+#include "HashStringCPP.h"
 #include "QSObjectCpp.h"
+#include "QSSchema.h"
+#include "QSSerializerCpp.h"
 
+#include <QJSEngine>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QMetaObject>
 #include <QMetaMethod>
+#include <QMetaProperty>
+
+#include <algorithm>
+#include <utility>
+
+/* ************************************************************************************************
+ * Private Types (defined first, as they are instantiated throughout)
+ * ************************************************************************************************/
+/*! Appends the item unless its key is pending already. Returns whether the item was appended.
+ * ************************************************************************************************/
+template <typename Key>
+bool QSRepositoryCpp::PendingList<Key>::append(const Key &key, const QVariant &item)
+{
+    if (indices.contains(key)) { return false; }
+
+    indices.insert(key, items.size());
+    items.append(item);
+
+    return true;
+}
+
+/*! Replaces the item of key by a tombstone. Returns whether the key was pending.
+ * ************************************************************************************************/
+template <typename Key>
+bool QSRepositoryCpp::PendingList<Key>::remove(const Key &key)
+{
+    const auto it = indices.constFind(key);
+    if (it == indices.cend()) { return false; }
+
+    items[it.value()] = QVariant();
+    indices.erase(it);
+
+    // Keep tombstones from dominating the list (amortized constant time)
+    if (++tombstones > items.size() / 2) { compact(); }
+
+    return true;
+}
+
+template <typename Key>
+void QSRepositoryCpp::PendingList<Key>::assign(const QVariantList &newItems)
+{
+    items.clear();
+    indices.clear();
+    tombstones = 0;
+
+    for (const QVariant &item : newItems) {
+        append(keyOf(item), item);
+    }
+}
+
+/*! Returns the pending items (without tombstones)
+ * ************************************************************************************************/
+template <typename Key>
+QVariantList QSRepositoryCpp::PendingList<Key>::values() const
+{
+    if (tombstones > 0) { compact(); }
+
+    return items;
+}
+
+template <>
+const QObject *QSRepositoryCpp::PendingList<const QObject*>::keyOf(const QVariant &item)
+{
+    return item.value<QObject*>();
+}
+
+template <>
+QString QSRepositoryCpp::PendingList<QString>::keyOf(const QVariant &item)
+{
+    return item.toString();
+}
+
+/*! Drops all tombstones in a single pass
+ * ************************************************************************************************/
+template <typename Key>
+void QSRepositoryCpp::PendingList<Key>::compact() const
+{
+    items.removeIf([](const QVariant &item) { return !item.isValid(); });
+    tombstones = 0;
+
+    for (qsizetype i = 0; i < items.size(); ++i) {
+        indices[keyOf(items.at(i))] = i;
+    }
+}
 
 /* ************************************************************************************************
  * Public Constructors & Destructor
@@ -19,6 +109,31 @@ QSRepositoryCpp::QSRepositoryCpp(QObject *parent)
   , m_name          ("Repo")
   , m_objects       ()
   , m_rootObject    (nullptr)
+  , m_revision      (0)
+  , m_snapshotObjects()
+  , m_snapshotDirtyIds()
+  , m_batchDepth    (0)
+  , m_batchUpdated  (false)
+  , m_forwardedAddedPending  ()
+  , m_forwardedDeletedPending()
+  , m_forwardedFlushScheduled(false)
+  , m_undoHistory   (new QSUndoHistoryCpp(this))
+  , m_collector     (new QSGarbageCollectorCpp(this))
+  , m_objectPool    (new QSObjectPoolCpp(this))
+  , m_recorder      (new QSMutationRecorderCpp(this))
+  , m_indexedFile   ()
+  , m_pagedOutIds   ()
+  , m_typeIndex     ()
+  , m_propertyIndices()
+  , m_references    ()
+  , m_referrers     ()
+  , m_contentHashes (256)
+  , m_hashDirtyIds  ()
+  , m_persistedHashes()
+  , m_digestBuckets (256, 0)
+  , m_digestDirtyBuckets()
+  , m_repoDigest    (0)
+  , m_storagePropsMethod(-2)
 {
     // Propagate availability changes to qsobjects
     connect(this, &QSObjectCpp::isAvailableChanged, this, &QSRepositoryCpp::onIsAvailableChanged);
@@ -31,11 +146,176 @@ QSRepositoryCpp::~QSRepositoryCpp()
     // Fall-through
 }
 
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+/*! Returns an immutable snapshot of all objects that can be read from any thread. Only objects
+ *  that were added or changed since the previous snapshot are serialized, all others are shared.
+ *
+ *  \note Must be called from the thread owning the repository.
+ * ************************************************************************************************/
+QSRepositorySnapshot QSRepositoryCpp::snapshot()
+{
+    // Re-serialize dirty objects, drop deleted ones
+    for (const QString &uuidStr : std::as_const(m_snapshotDirtyIds)) {
+        QSObjectCpp *qsObject = m_objects.value(uuidStr).value<QSObjectCpp*>();
+
+        if (qsObject == nullptr) {
+            m_snapshotObjects.remove(uuidStr);
+            continue;
+        }
+
+        m_snapshotObjects.insert(uuidStr, QSRepositorySnapshot::ObjectData::create(
+                                              getStorageProps(qsObject)));
+    }
+    m_snapshotDirtyIds.clear();
+
+    return QSRepositorySnapshot(getUuidStr(),
+                                m_rootObject != nullptr ? m_rootObject->getUuidStr() : QString(),
+                                m_snapshotObjects,
+                                m_revision);
+}
+
+/*! Informs the repo about changes that are not notified by a property of the object, e.g., changes
+ *  inside an object list (see QSObjectListCpp). propName can be empty if unknown.
+ * ************************************************************************************************/
+void QSRepositoryCpp::notifyObjectChanged(QSObjectCpp *qsObject, const QString &propName)
+{
+    // Sanity check: only local objects are observed
+    if (qsObject == nullptr || m_objects.value(qsObject->getUuidStr()).value<QSObjectCpp*>() != qsObject) {
+        return;
+    }
+
+    handleObjectChanged(qsObject, propName.isEmpty()
+                                ? -1
+                                : qsObject->metaObject()->indexOfProperty(propName.toLatin1().constData()));
+}
+
+/* ************************************************************************************************
+ * Public Getters
+ * ************************************************************************************************/
+/*! Returns the objects added since the pending changes were last reset
+ * ************************************************************************************************/
+QVariantList QSRepositoryCpp::getAddedObjects() const
+{
+    return m_addedObjects.values();
+}
+
+/*! Returns the UUIDs of the objects deleted since the pending changes were last reset
+ * ************************************************************************************************/
+QVariantList QSRepositoryCpp::getDeletedObjects() const
+{
+    return m_deletedObjects.values();
+}
+
+/*! Returns the objects updated since the pending changes were last reset
+ * ************************************************************************************************/
+QVariantList QSRepositoryCpp::getUpdatedObjects() const
+{
+    return m_updatedObjects.values();
+}
+
+/*! Returns whether a batch is in progress (see beginBatch())
+ * ************************************************************************************************/
+bool QSRepositoryCpp::isBatching() const
+{
+    return m_batchDepth > 0;
+}
+
+/*! Returns the object with uuidStr, falling through to forwarded repos if it's not a local object
+ * ************************************************************************************************/
+QSObjectCpp *QSRepositoryCpp::getObject(const QString &uuidStr) const
+{
+    if (QSObjectCpp *qsObject = m_objects.value(uuidStr).value<QSObjectCpp*>()) {
+        return qsObject;
+    }
+
+    for (const QVariant &qsRepoVar : m_forwardedRepos) {
+        if (QSRepositoryCpp *qsRepo = qsRepoVar.value<QSRepositoryCpp*>()) {
+            if (QSObjectCpp *qsObject = qsRepo->getObject(uuidStr)) {
+                return qsObject;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+/*! Returns the undo/redo history of this repository (disabled by default)
+ * ************************************************************************************************/
+QSUndoHistoryCpp *QSRepositoryCpp::getUndoHistory() const
+{
+    return m_undoHistory;
+}
+
+/*! Returns the garbage collector of this repository
+ * ************************************************************************************************/
+QSGarbageCollectorCpp *QSRepositoryCpp::getCollector() const
+{
+    return m_collector;
+}
+
+/*! Returns the pool of recycled objects of this repository
+ * ************************************************************************************************/
+QSObjectPoolCpp *QSRepositoryCpp::getObjectPool() const
+{
+    return m_objectPool;
+}
+
+/*! Returns the recorder of mutations (stopped by default)
+ * ************************************************************************************************/
+QSMutationRecorderCpp *QSRepositoryCpp::getRecorder() const
+{
+    return m_recorder;
+}
+
+/* ************************************************************************************************
+ * Public Setters
+ * ************************************************************************************************/
+/*! Replaces the pending added objects, e.g., to reset them after they were synchronized
+ * ************************************************************************************************/
+void QSRepositoryCpp::setAddedObjects(const QVariantList &addedObjects)
+{
+    m_addedObjects.assign(addedObjects);
+    emit addedObjectsChanged();
+}
+
+/*! Replaces the pending deleted UUIDs, e.g., to reset them after they were synchronized
+ * ************************************************************************************************/
+void QSRepositoryCpp::setDeletedObjects(const QVariantList &deletedObjects)
+{
+    m_deletedObjects.assign(deletedObjects);
+    emit deletedObjectsChanged();
+}
+
+/*! Replaces the pending updated objects, e.g., to reset them after they were synchronized
+ * ************************************************************************************************/
+void QSRepositoryCpp::setUpdatedObjects(const QVariantList &updatedObjects)
+{
+    m_updatedObjects.assign(updatedObjects);
+    emit updatedObjectsChanged();
+}
+
+/*! Returns whether qsRepository is forwarded by this repo (directly or indirectly)
+ * ************************************************************************************************/
+bool QSRepositoryCpp::isForwarding(const QSRepositoryCpp *qsRepository) const
+{
+    for (const QVariant &qsRepoVar : m_forwardedRepos) {
+        const QSRepositoryCpp *qsRepo = qsRepoVar.value<QSRepositoryCpp*>();
+
+        if (qsRepo == qsRepository || (qsRepo != nullptr && qsRepo->isForwarding(qsRepository))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /* ************************************************************************************************
  * Public Slots
  * ************************************************************************************************/
-/*! Adds all objects of qsRepository to local repo in order to forward them, and subscribes to
- *  their changes.
+/*! Forwards qsRepository: its objects become visible through this repo (see getObject()) without
+ *  being copied, and its additions/deletions are relayed in batches.
  * ************************************************************************************************/
 bool QSRepositoryCpp::forwardRepo(QSRepositoryCpp *qsRepository)
 {
@@ -49,38 +329,51 @@ bool QSRepositoryCpp::forwardRepo(QSRepositoryCpp *qsRepository)
         return false;
     }
 
-    // Add all existing objects
-    for (const QVariant &qsObjectVar : qsRepository->m_objects) {
-        if (QSObjectCpp *qsObject = qsObjectVar.value<QSObjectCpp*>()) {
-            addObject(qsObject->getUuidStr(), qsObject, true);
-        }
+    // Sanity check: Abort if this would create a forwarding cycle
+    if (qsRepository == this || qsRepository->isForwarding(this)) {
+        qWarning() << "Cannot forward repo" << qsRepository->getUuidStr() << "-- cyclic forwarding!";
+        return false;
     }
 
-    // Subscribe to insert added objects
-    connect(qsRepository, &QSRepositoryCpp::objectAdded, this, [=](QSObjectCpp *addedObject) {
+    // Queue changes of the forwarded repo, they are relayed once per event loop iteration. Single
+    // changes are signalled per object, batches of several objects in bulk only (see commitBatch()).
+    const auto recordAdded = [=](QSObjectCpp *addedObject) {
         // Sanity check
         if (addedObject == nullptr) {
             qWarning() << "Attempted to add nullptr object. Skipping!";
             return;
         }
 
-        addObject(addedObject->getUuidStr(), addedObject, true);
+        recordForwardedAdd(addedObject->getUuidStr(), addedObject);
+    };
+
+    connect(qsRepository, &QSRepositoryCpp::objectAdded, this, recordAdded);
+    connect(qsRepository, &QSRepositoryCpp::objectsAdded, this, [=](const QVariantList &addedObjects) {
+        for (const QVariant &addedObject : addedObjects) {
+            recordAdded(addedObject.value<QSObjectCpp*>());
+        }
     });
 
-    // Subscribe to remove deleted objects
     connect(qsRepository, &QSRepositoryCpp::objectDeleted, this, [=](const QString &deletedId) {
-        delObject(deletedId);
+        recordForwardedDel(deletedId);
+    });
+    connect(qsRepository, &QSRepositoryCpp::objectsDeleted, this, [=](const QStringList &deletedIds) {
+        for (const QString &deletedId : deletedIds) {
+            recordForwardedDel(deletedId);
+        }
     });
 
     qDebug() << "Forwarding Repo: " << qsRepository->getUuidStr();
 
     m_forwardedRepos.append(QVariant::fromValue(qsRepository));
     emit forwardedReposChanged();
+    emit objectsChanged();
 
     return true;
 }
 
-/*! Removes all forwarded objects of qsRepository, and unsubscribes from changes.
+/*! Stops forwarding qsRepository and unsubscribes from changes. As forwarded objects are never
+ *  copied, this does not depend on the number of objects.
  * ************************************************************************************************/
 bool QSRepositoryCpp::unforwardRepo(QSRepositoryCpp *qsRepository)
 {
@@ -97,20 +390,23 @@ bool QSRepositoryCpp::unforwardRepo(QSRepositoryCpp *qsRepository)
     // Unsubscribe everything
     disconnect(qsRepository, nullptr, this, nullptr);
 
-    // Remove all objects of repo
-    for (const QVariant &qsObjectVar : qsRepository->m_objects) {
-        if (QSObjectCpp *qsObject = qsObjectVar.value<QSObjectCpp*>()) {
-            delObject(qsObject->getUuidStr());
-        }
-    }
-
     qDebug() << "Stopped Forwarding Repo: " << qsRepository->getUuidStr();
     m_forwardedRepos.removeAll(QVariant::fromValue(qsRepository));
     emit forwardedReposChanged();
+    emit objectsChanged();
 
     return true;
 }
 
+/*! Returns the object with uuidStr (as QML value), falling through to forwarded repos
+ * ************************************************************************************************/
+QVariant QSRepositoryCpp::findObject(const QString &uuidStr) const
+{
+    QSObjectCpp *qsObject = getObject(uuidStr);
+
+    return qsObject != nullptr ? QVariant::fromValue(qsObject) : QVariant();
+}
+
 /*! Registers an object with the repository
  * ************************************************************************************************/
 bool QSRepositoryCpp::registerObject(QSObjectCpp *qsObject)
@@ -149,172 +445,1620 @@ bool QSRepositoryCpp::unregisterObject(QSObjectCpp *qsObject)
     return true;
 }
 
-/* ************************************************************************************************
- * Protected Slots
+/*! Starts a batch: objects are still (un)registered immediately, but all notifications are deferred
+ *  to a single consolidated emission in commitBatch(). Batches can be nested, only the outermost
+ *  commit emits.
  * ************************************************************************************************/
-/*! Adds an QSObject to the repository
+bool QSRepositoryCpp::beginBatch()
+{
+    if (m_batchDepth++ > 0) { return true; }
+
+    // Keep pending changes for rollback (implicitly shared, only copied when modified)
+    m_batchAddedBackup   = m_addedObjects;
+    m_batchDeletedBackup = m_deletedObjects;
+
+    emit isBatchingChanged();
+
+    return true;
+}
+
+/*! Finishes a batch and informs observers about all net additions and deletions at once: a single
+ *  objectsDeleted() and objectsAdded() (objectDeleted()/objectAdded() if only one object changed,
+ *  see emitObjectsDeleted())
  * ************************************************************************************************/
-bool QSRepositoryCpp::addObject(const QString &uuidStr, QSObjectCpp *qsObject, bool force)
+bool QSRepositoryCpp::commitBatch()
 {
-    // Sanity check: skip if already added
-    if (m_objects.contains(uuidStr)) {
-        // If forced, unobserve old object
-        if (force) {
-            unobserveObject(m_objects[uuidStr].value<QSObjectCpp*>());
-        } else {
-            qWarning() << "Skipped adding object" << uuidStr << "-- uuid already registered!";
-            return false;
-        }
+    // Sanity check
+    if (m_batchDepth == 0) {
+        qWarning() << "Attempted to commit batch without beginBatch()";
+        return false;
     }
 
-    // Remove from deleted objects if rquired
-    m_deletedObjects.removeAll(uuidStr);
+    if (--m_batchDepth > 0) { return true; }
 
-    // Add to local administration
-    m_objects[uuidStr] = QVariant::fromValue(qsObject);
+    QStringList deletedIds = m_batchDeletedObjects.keys();
 
-    // Start listening to changes on object (local only)
-    observeObject(qsObject);
+    QVariantList addedObjects;
+    addedObjects.reserve(m_batchAddedObjects.size());
+    for (const QPointer<QSObjectCpp> &qsObject : std::as_const(m_batchAddedObjects)) {
+        if (!qsObject.isNull()) {
+            addedObjects.append(QVariant::fromValue(qsObject.data()));
+        }
+    }
+
+    const bool isUpdated = m_batchUpdated;
+
+    resetBatch();
 
-    emit objectAdded(qsObject);
+    // Inform observers (deletions first, to allow replacement of objects with the same UUID)
+    emitObjectsDeleted(deletedIds);
+    emitObjectsAdded(addedObjects);
 
     if (!m_isLoading) {
-        emit objectsChanged();
+        if (!(deletedIds.isEmpty() && addedObjects.isEmpty())) { emit objectsChanged(); }
+        if (!addedObjects.isEmpty()) { emit addedObjectsChanged(); }
+        if (!deletedIds.isEmpty())   { emit deletedObjectsChanged(); }
     }
 
-    // Record added object
-    if (!m_addedObjects.contains(QVariant::fromValue(qsObject))) {
-        m_addedObjects.append(QVariant::fromValue(qsObject));
+    if (isUpdated) { emit updatedObjectsChanged(); }
 
-        if (!m_isLoading) {
-            emit addedObjectsChanged();
-        }
-    }
+    emit isBatchingChanged();
 
     return true;
 }
 
-/*! Removes all QSObjects from the repository
+/*! Aborts a batch (including all nested ones): undoes additions and restores deleted objects that
+ *  still exist. Both take the regular delete/add path (i.e., are recorded for undo and replay), but
+ *  no add/delete notifications are emitted as observers never saw the batch.
+ *
+ *  \note Property changes made during the batch are NOT reverted
  * ************************************************************************************************/
-bool QSRepositoryCpp::clearObjects()
+bool QSRepositoryCpp::rollbackBatch()
 {
-    // Sanity check: skip if nothing to be done
-    if (m_objects.empty()) { return false; }
-
-    bool isChanged = false;
-
-    // Remove all
-    while (!m_objects.empty()) {
-        // Make a copy of key to prevent deletion of temporary
-        const QString key = m_objects.firstKey();
-        isChanged |= delObject(key, true);
+    // Sanity check
+    if (m_batchDepth == 0) {
+        qWarning() << "Attempted to rollback batch without beginBatch()";
+        return false;
     }
 
-    if (!m_isLoading) {
-        emit objectsChanged();
-        emit deletedObjectsChanged();
+    if (m_batchDepth > 1) {
+        qWarning() << "Rolling back" << m_batchDepth << "nested batches";
     }
 
-    return isChanged;
-}
-
-/*! Removes an QSObject from the repository (by UUID)
- * ************************************************************************************************/
-bool QSRepositoryCpp::delObject(const QString &uuidStr, bool suppressSignal)
-{
-    // Sanity check: skip if already added
-    if (!m_objects.contains(uuidStr)) { return false; }
+    // Both are changed by delObject() and addObject() (cancelling out)
+    const QHash<QString, QPointer<QSObjectCpp>> addedObjects   = m_batchAddedObjects;
+    const QHash<QString, QPointer<QSObjectCpp>> deletedObjects = m_batchDeletedObjects;
 
-    // Remove the objet and disconnect all signals if we can find the object
-    if (QSObjectCpp *qsObject = m_objects.take(uuidStr).value<QSObjectCpp*>()) {
-        unobserveObject(qsObject);
+    // Undo additions
+    for (auto it = addedObjects.cbegin(); it != addedObjects.cend(); ++it) {
+        const QSObjectCpp *qsObject = m_objects.value(it.key()).value<QSObjectCpp*>();
 
-        // Remove from pending changes
-        // \note No signals emitted as the system should alreay have been triggered when added/updated
-        m_addedObjects.removeAll(QVariant::fromValue(qsObject));
-        m_updatedObjects.removeAll(QVariant::fromValue(qsObject));
+        if (qsObject == nullptr || qsObject != it.value()) { continue; }
 
-        emit objectDeleted(qsObject->getUuidStr());
+        delObject(it.key(), true);
     }
 
-    if (!(m_isLoading || suppressSignal)) {
-        emit objectsChanged();
-    }
+    // Restore deletions (objects that left the repo are registered again, including children)
+    for (auto it = deletedObjects.cbegin(); it != deletedObjects.cend(); ++it) {
+        QSObjectCpp *qsObject = it.value().data();
 
-    // Record deleted uuid
-    if (!m_deletedObjects.contains(uuidStr)) {
-        m_deletedObjects.append(uuidStr);
+        if (qsObject == nullptr) {
+            qWarning() << "Cannot restore destroyed object" << it.key();
+            continue;
+        }
 
-        if (!(m_isLoading || suppressSignal)) {
-            emit deletedObjectsChanged();
+        // Already restored with its parent
+        if (m_objects.value(it.key()).value<QSObjectCpp*>() == qsObject) { continue; }
+
+        if (qsObject->getRepo() != this) {
+            qsObject->setRepo(this);
+        } else {
+            addObject(it.key(), qsObject);
         }
     }
 
+    // Restore pending changes, objects that were rolled back were removed from updated objects
+    m_addedObjects   = m_batchAddedBackup;
+    m_deletedObjects = m_batchDeletedBackup;
+
+    const bool isUpdated = m_batchUpdated;
+
+    ++m_revision;
+    m_batchDepth = 0;
+    resetBatch();
+
+    if (isUpdated) { emit updatedObjectsChanged(); }
+
+    emit isBatchingChanged();
+
     return true;
 }
 
-/*! Makes all QSObjects in the repository unavailable when repo becomes unavailable. A re-sync of
- *  object availability will need to make these available again -- that way we prevent recently
- *  removed objects from appearing available after a reconnect, while they are not.
+/*! Returns whether the file is stored in the indexed layout (see QSIndexedFileCpp)
  * ************************************************************************************************/
-void QSRepositoryCpp::onIsAvailableChanged()
+bool QSRepositoryCpp::isIndexedFile(const QString &fileName) const
 {
-    if (!getIsAvailable()) {
-        for (QVariant &var : m_objects) {
-            if (QSObjectCpp *qsObject = var.value<QSObjectCpp*>()) {
-                qsObject->setIsAvailable(false);
-            }
-        }
-    }
+    return QSIndexedFileCpp::isIndexedFile(fileName);
 }
 
-void QSRepositoryCpp::onObjectChanged()
+bool QSRepositoryCpp::isIndexedFile(const QUrl &fileUrl) const
 {
-    // Store reference to updated object
-    if (!m_updatedObjects.contains(QVariant::fromValue(sender()))) {
-//        qDebug() << sender()->metaObject()->method(senderSignalIndex()).name();
-
-        m_updatedObjects.append(QVariant::fromValue(sender()));
-        emit updatedObjectsChanged();
-    }
+    return isIndexedFile(fileUrl.toLocalFile());
 }
 
-/* Private Functions
+/*! Opens an indexed file for on-demand loading. All objects of the file that are not part of the
+ *  repo yet are considered paged out.
  * ************************************************************************************************/
-/*! Connects to all object Changed() signals, exluding 'private' properties starting with _ and
- *  properties of derived classes if an interface is used
- * ************************************************************************************************/
-void QSRepositoryCpp::observeObject(QSObjectCpp *qsObject)
+bool QSRepositoryCpp::openIndexedFile(const QString &fileName)
 {
-    // Cache targeted slot: QSRepositoryCpp::onObjectChanged()
-    static const QMetaMethod metaOnObjectChanged =
-        metaObject()->method(QSRepositoryCpp::staticMetaObject.indexOfSlot("onObjectChanged()"));
-
-    // Connect all Changed() signals of qsObject by iterating over all its superclasses
-    const QMetaObject* metaObject = qsObject->metaObject();
-
-    // Limit observation of properties to most specific interface (if applicable)
-    int lastMethod = qsObject->getInterfaceMetaObject() != nullptr
-                   ? qsObject->getInterfaceMetaObject()->methodCount()
-                   : metaObject->methodCount();
+    m_pagedOutIds.clear();
 
-    // Observe all propChanged() signals
-    for(int i = 0; i < lastMethod; ++i) {
-        const QMetaMethod metaMethod = metaObject->method(i);
+    if (!m_indexedFile.open(fileName)) { return false; }
 
-        if (metaMethod.methodType() == QMetaMethod::Signal
-                && !metaMethod.name().startsWith("_")
-                && metaMethod.name().endsWith("Changed"))
-        {
-            connect(qsObject, metaMethod, this, metaOnObjectChanged);
-//            qDebug() << "CONNECTED " << metaObject->className() << metaMethod.name();
+    for (const QString &uuidStr : m_indexedFile.objectIds()) {
+        if (!m_objects.contains(uuidStr)) {
+            m_pagedOutIds.insert(uuidStr);
         }
     }
+
+    return true;
 }
 
-/*! Disconnects all signals between object and this repo
+bool QSRepositoryCpp::openIndexedFile(const QUrl &fileUrl)
+{
+    return openIndexedFile(fileUrl.toLocalFile());
+}
+
+/*! Closes the indexed file, objects that were not loaded are forgotten
  * ************************************************************************************************/
-void QSRepositoryCpp::unobserveObject(QSObjectCpp *qsObject)
+void QSRepositoryCpp::closeIndexedFile()
 {
-    disconnect(qsObject, nullptr, this, nullptr);
+    m_indexedFile.close();
+    m_pagedOutIds.clear();
+}
+
+bool QSRepositoryCpp::isIndexedFileOpen() const
+{
+    return m_indexedFile.isOpen();
+}
+
+/*! Writes a repo dump (see QSRepository.dumpRepo()) as indexed file. Objects missing in the dump
+ *  (paged out, or unchanged, see getChangedObjectIds()) are copied from the open indexed file, so
+ *  partially loaded repos are saved completely. The written file becomes the open indexed file.
+ * ************************************************************************************************/
+bool QSRepositoryCpp::writeIndexedFile(const QString &fileName, const QVariantMap &repoDump)
+{
+    QVariantMap                 meta;
+    QHash<QString, QByteArray>  objects;
+
+    objects.reserve(m_objects.size() + m_pagedOutIds.size());
+
+    for (auto it = repoDump.cbegin(); it != repoDump.cend(); ++it) {
+        if (it.value().typeId() == QMetaType::QVariantMap) {
+            objects.insert(it.key(), QJsonDocument(QJsonObject::fromVariantMap(it.value().toMap()))
+                                         .toJson(QJsonDocument::Compact));
+        } else {
+            meta.insert(it.key(), it.value());
+        }
+    }
+
+    const auto copyIndexedObject = [&](const QString &uuidStr) {
+        if (objects.contains(uuidStr)) { return; }
+
+        if (m_indexedFile.contains(uuidStr)) {
+            objects.insert(uuidStr, m_indexedFile.readRaw(uuidStr));
+        } else {
+            qWarning() << "[QSRepo] Missing object" << uuidStr << "when writing" << fileName;
+        }
+    };
+
+    for (const QString &uuidStr : std::as_const(m_pagedOutIds)) {
+        copyIndexedObject(uuidStr);
+    }
+
+    if (m_indexedFile.isOpen()) {
+        for (auto it = m_objects.keyBegin(); it != m_objects.keyEnd(); ++it) {
+            copyIndexedObject(*it);
+        }
+    }
+
+    // Release the file when overwriting it (all objects were read into memory). Evicted objects
+    // only exist in the swap file, which does not survive closing.
+    const bool isOverwritten = m_indexedFile.isOpen() && m_indexedFile.fileName() == fileName;
+
+    QStringList swappedIds;
+    if (isOverwritten) {
+        for (const QString &uuidStr : std::as_const(m_pagedOutIds)) {
+            if (m_indexedFile.isSwapped(uuidStr)) { swappedIds.append(uuidStr); }
+        }
+
+        m_indexedFile.close();
+    }
+
+    if (!QSIndexedFileCpp::write(fileName, meta, objects)) {
+        qWarning() << "[QSRepo] Could not write" << fileName;
+
+        // Reopen the old file and evict the objects again
+        if (isOverwritten) {
+            const QSet<QString> pagedOutIds = m_pagedOutIds;
+
+            if (m_indexedFile.open(fileName)) {
+                for (const QString &uuidStr : std::as_const(swappedIds)) {
+                    m_indexedFile.evictRaw(uuidStr, objects.value(uuidStr));
+                }
+            }
+
+            m_pagedOutIds = pagedOutIds;
+        }
+        return false;
+    }
+
+    return openIndexedFile(fileName);
+}
+
+bool QSRepositoryCpp::writeIndexedFile(const QUrl &fileUrl, const QVariantMap &repoDump)
+{
+    return writeIndexedFile(fileUrl.toLocalFile(), repoDump);
+}
+
+/*! Returns the non-object entries of the indexed file (root, version, application)
+ * ************************************************************************************************/
+QVariantMap QSRepositoryCpp::getIndexedFileMeta() const
+{
+    return m_indexedFile.meta();
+}
+
+/*! Returns whether the object is stored in the open indexed file
+ * ************************************************************************************************/
+bool QSRepositoryCpp::isIndexedObject(const QString &uuidStr) const
+{
+    return m_indexedFile.contains(uuidStr);
+}
+
+/*! Returns whether the object is stored in the indexed file but not loaded
+ * ************************************************************************************************/
+bool QSRepositoryCpp::isPagedOut(const QString &uuidStr) const
+{
+    return m_pagedOutIds.contains(uuidStr);
+}
+
+QStringList QSRepositoryCpp::getPagedOutIds() const
+{
+    return m_pagedOutIds.values();
+}
+
+/*! Reads objects from the indexed file. With references, all paged out objects referenced by them
+ *  are read as well (transitively), so the result can be loaded without dangling references.
+ * ************************************************************************************************/
+QVariantMap QSRepositoryCpp::readIndexedObjects(const QStringList &uuidStrs, bool withReferences)
+{
+    QVariantMap jsonObjects;
+    QStringList pending = uuidStrs;
+
+    // Only objects that were requested explicitly are read even if loaded
+    const QSet<QString> requestedIds(uuidStrs.cbegin(), uuidStrs.cend());
+
+    while (!pending.isEmpty()) {
+        const QString uuidStr = pending.takeLast();
+
+        if (jsonObjects.contains(uuidStr) || !m_indexedFile.contains(uuidStr)) { continue; }
+        if (!requestedIds.contains(uuidStr) && !m_pagedOutIds.contains(uuidStr)) { continue; }
+
+        const QVariantMap jsonObj = m_indexedFile.read(uuidStr);
+        if (jsonObj.isEmpty()) {
+            qWarning() << "[QSRepo] Could not read indexed object" << uuidStr;
+            continue;
+        }
+
+        if (withReferences) {
+            QSSerializerCpp::collectQSUrls(jsonObj, pending);
+        }
+
+        jsonObjects.insert(uuidStr, jsonObj);
+    }
+
+    return jsonObjects;
+}
+
+/*! Writes the current state of (cold) objects to the swap file of the indexed file, removes them
+ *  from the repo and destroys them. They are paged in again when resolved.
+ *
+ *  Objects that are referenced by objects staying loaded are skipped, as the references would
+ *  dangle. Objects only referenced by other evicted objects (e.g., a subgraph) are evicted. Only
+ *  objects owned by the repo (e.g., loaded from a file) are evicted, objects with another parent
+ *  (e.g., created by the UI) are skipped. objectsEvicted() is emitted before the evicted objects are
+ *  destroyed, so pointers held elsewhere (e.g., by QML) can be dropped.
+ *
+ *  Returns the UUIDs of the evicted objects.
+ * ************************************************************************************************/
+QStringList QSRepositoryCpp::evictObjects(const QStringList &uuidStrs)
+{
+    QStringList         evictedIds;
+    QList<QSObjectCpp*> evictedObjects;
+
+    // Sanity check
+    if (!m_indexedFile.isOpen()) { return evictedIds; }
+
+    // Candidates: loaded objects owned by the repo, except the root
+    QSet<QString> candidateIds;
+    for (const QString &uuidStr : uuidStrs) {
+        const QSObjectCpp *qsObject = m_objects.value(uuidStr).value<QSObjectCpp*>();
+
+        if (qsObject != nullptr && qsObject != m_rootObject && qsObject->parent() == this) {
+            candidateIds.insert(uuidStr);
+        }
+    }
+
+    // Drop candidates referenced from outside the candidates (repeated, as this can expose others)
+    for (bool isChanged = true; isChanged; ) {
+        isChanged = false;
+
+        for (auto it = candidateIds.begin(); it != candidateIds.end(); ) {
+            const QHash<QString, int> referrers = m_referrers.value(*it);
+            const bool isReferenced = std::any_of(referrers.keyBegin(), referrers.keyEnd(),
+                                                  [&](const QString &referrerId) {
+                                                      return !candidateIds.contains(referrerId);
+                                                  });
+            if (isReferenced) {
+                it = candidateIds.erase(it);
+                isChanged = true;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    for (const QString &uuidStr : uuidStrs) {
+        // Sanity check: skip objects that are referenced (or listed twice)
+        if (!candidateIds.remove(uuidStr)) { continue; }
+
+        QSObjectCpp *qsObject = m_objects.value(uuidStr).value<QSObjectCpp*>();
+
+        if (m_indexedFile.evict(uuidStr, getStorageProps(qsObject))) {
+            evictedIds.append(uuidStr);
+            evictedObjects.append(qsObject);
+        }
+    }
+
+    // Remove from repo, evicted objects are not deleted from the repo's point of view
+    delObjects(evictedIds);
+
+    for (const QString &uuidStr : std::as_const(evictedIds)) {
+        m_pagedOutIds.insert(uuidStr);
+        m_deletedObjects.remove(uuidStr);
+    }
+
+    if (!evictedIds.isEmpty()) { emit objectsEvicted(evictedIds); }
+
+    // Recycle evicted objects if possible, as they are likely to be paged in again
+    for (QSObjectCpp *qsObject : std::as_const(evictedObjects)) {
+        if (!m_objectPool->recycle(qsObject)) {
+            qsObject->setRepo(nullptr);
+            qsObject->deleteLater();
+        }
+    }
+
+    return evictedIds;
+}
+
+/*! Returns the qsTypes of all objects in the repository
+ * ************************************************************************************************/
+QStringList QSRepositoryCpp::getObjectTypes() const
+{
+    return m_typeIndex.keys();
+}
+
+int QSRepositoryCpp::countObjectsByType(const QString &qsType) const
+{
+    return m_typeIndex.value(qsType).size();
+}
+
+/*! Returns all objects of qsType (exact type, no subtypes)
+ * ************************************************************************************************/
+QVariantList QSRepositoryCpp::findObjectsByType(const QString &qsType) const
+{
+    QVariantList qsObjects;
+
+    const auto typeIt = m_typeIndex.constFind(qsType);
+    if (typeIt == m_typeIndex.constEnd()) { return qsObjects; }
+
+    qsObjects.reserve(typeIt->size());
+    for (QSObjectCpp *qsObject : *typeIt) {
+        qsObjects.append(QVariant::fromValue(qsObject));
+    }
+
+    return qsObjects;
+}
+
+/*! Starts maintaining a value index of propName for all objects having this property
+ *
+ *  \note Only changes notified by the observed xxxChanged() signals update the index
+ * ************************************************************************************************/
+bool QSRepositoryCpp::addPropertyIndex(const QString &propName)
+{
+    // Sanity check
+    if (propName.isEmpty() || m_propertyIndices.contains(propName)) { return false; }
+
+    m_propertyIndices.insert(propName, PropertyIndex());
+
+    for (auto it = m_objects.cbegin(); it != m_objects.cend(); ++it) {
+        indexProperty(propName, it.key(), it.value().value<QSObjectCpp*>());
+    }
+
+    return true;
+}
+
+bool QSRepositoryCpp::removePropertyIndex(const QString &propName)
+{
+    return m_propertyIndices.remove(propName);
+}
+
+QStringList QSRepositoryCpp::getPropertyIndices() const
+{
+    return m_propertyIndices.keys();
+}
+
+/*! Returns all objects whose propName equals value (compared in serialized form, so objects match
+ *  by reference). Falls back to a scan if propName is not indexed.
+ * ************************************************************************************************/
+QVariantList QSRepositoryCpp::findObjectsByProperty(const QString &propName,
+                                                    const QVariant &value) const
+{
+    QVariantList     qsObjects;
+    const QByteArray valueKey = QSSerializerCpp::toCompactJson(QSSerializerCpp::getQSProp(value));
+
+    const auto indexIt = m_propertyIndices.constFind(propName);
+
+    // Scan all objects if not indexed
+    if (indexIt == m_propertyIndices.constEnd()) {
+        const QByteArray propNameLatin1 = propName.toLatin1();
+
+        for (const QVariant &qsObjectVar : m_objects) {
+            const QSObjectCpp *qsObject = qsObjectVar.value<QSObjectCpp*>();
+            if (qsObject == nullptr) { continue; }
+
+            const QVariant propValue = qsObject->property(propNameLatin1.constData());
+
+            if (propValue.isValid() && QSSerializerCpp::toCompactJson(
+                                           QSSerializerCpp::getQSProp(propValue)) == valueKey) {
+                qsObjects.append(qsObjectVar);
+            }
+        }
+
+        return qsObjects;
+    }
+
+    const QSet<QString> uuidStrs = indexIt->uuidsByValue.value(valueKey);
+
+    qsObjects.reserve(uuidStrs.size());
+    for (const QString &uuidStr : uuidStrs) {
+        qsObjects.append(m_objects.value(uuidStr));
+    }
+
+    return qsObjects;
+}
+
+/*! Returns the UUIDs of all objects holding a reference to the object (O(number of referrers))
+ * ************************************************************************************************/
+QStringList QSRepositoryCpp::getReferrers(const QString &uuidStr) const
+{
+    return m_referrers.value(uuidStr).keys();
+}
+
+/*! Returns the UUIDs of all objects referenced by the object
+ * ************************************************************************************************/
+QStringList QSRepositoryCpp::getReferences(const QString &uuidStr) const
+{
+    QSet<QString> targetIds;
+
+    for (const QStringList &propTargetIds : m_references.value(uuidStr)) {
+        targetIds.unite(QSet<QString>(propTargetIds.cbegin(), propTargetIds.cend()));
+    }
+
+    return targetIds.values();
+}
+
+bool QSRepositoryCpp::isReferenced(const QString &uuidStr) const
+{
+    return m_referrers.contains(uuidStr);
+}
+
+/*! Rebuilds the references held by the objects, e.g., after their URLs were resolved on load
+ * ************************************************************************************************/
+void QSRepositoryCpp::updateReferences(const QStringList &uuidStrs)
+{
+    for (const QString &uuidStr : uuidStrs) {
+        indexReferences(uuidStr, m_objects.value(uuidStr).value<QSObjectCpp*>());
+    }
+}
+
+/*! Deletes the object and applies policy to the references to it. Cascading also deletes objects
+ *  only referenced by deleted objects (the root object is never deleted). All changes are a
+ *  single batch and undo command. Returns the UUIDs of all deleted objects.
+ * ************************************************************************************************/
+QStringList QSRepositoryCpp::deleteObject(const QString &uuidStr, DeletePolicy policy)
+{
+    QStringList deletedIds;
+
+    // Sanity check
+    if (!m_objects.contains(uuidStr)) { return deletedIds; }
+
+    m_undoHistory->beginCommand(QStringLiteral("Delete"));
+    beginBatch();
+
+    // Queue of objects to be deleted, with sets for constant time lookups in the cascade
+    QStringList   pendingIds { uuidStr };
+    QSet<QString> pendingIdSet { uuidStr };
+    QSet<QString> deletedIdSet;
+
+    for (qsizetype i = 0; i < pendingIds.size(); ++i) {
+        const QString deletedId = pendingIds.at(i);
+        QSObjectCpp  *qsObject  = m_objects.value(deletedId).value<QSObjectCpp*>();
+
+        pendingIdSet.remove(deletedId);
+
+        if (qsObject == nullptr || deletedIdSet.contains(deletedId)) { continue; }
+
+        // Remove references from referrers (writes are indexed by onObjectChanged())
+        if (policy != KeepReferences) {
+            const QStringList referrerIds = getReferrers(deletedId);
+
+            for (const QString &referrerId : referrerIds) {
+                QSObjectCpp *referrer = m_objects.value(referrerId).value<QSObjectCpp*>();
+                if (referrer == nullptr) { continue; }
+
+                const QStringList propNames = m_references.value(referrerId).keys();
+                for (const QString &propName : propNames) {
+                    if (!m_references.value(referrerId).value(propName).contains(deletedId)) {
+                        continue;
+                    }
+
+                    const QByteArray propNameLatin1 = propName.toLatin1();
+                    const QVariant   propValue = referrer->property(propNameLatin1.constData());
+                    QVariant         newValue  = QSSerializerCpp::removeReference(propValue,
+                                                                                  qsObject);
+
+                    // Write JS values back as JS values, so arrays/objects of 'property var'
+                    // keep their type
+                    if (propValue.metaType() == QMetaType::fromType<QJSValue>()) {
+                        if (QJSEngine *engine = qjsEngine(referrer)) {
+                            newValue = QVariant::fromValue(engine->toScriptValue(newValue));
+                        }
+                    }
+
+                    referrer->setProperty(propNameLatin1.constData(), newValue);
+                }
+
+                // Keep index correct for properties without notification
+                indexReferences(referrerId, referrer);
+            }
+        }
+
+        const QStringList targetIds = getReferences(deletedId);
+
+        delObject(deletedId);
+        deletedIds.append(deletedId);
+        deletedIdSet.insert(deletedId);
+
+        // Cascade to targets that are not referenced anymore
+        if (policy == CascadeReferences) {
+            for (const QString &targetId : targetIds) {
+                const QSObjectCpp *target = m_objects.value(targetId).value<QSObjectCpp*>();
+
+                if (target != nullptr && target != m_rootObject && !pendingIdSet.contains(targetId)) {
+                    const QStringList referrerIds = getReferrers(targetId);
+
+                    if (std::all_of(referrerIds.cbegin(), referrerIds.cend(),
+                                    [&](const QString &referrerId) {
+                                        return referrerId == deletedId
+                                            || deletedIdSet.contains(referrerId)
+                                            || pendingIdSet.contains(referrerId);
+                                    })) {
+                        pendingIds.append(targetId);
+                        pendingIdSet.insert(targetId);
+                    }
+                }
+            }
+        }
+    }
+
+    commitBatch();
+    m_undoHistory->endCommand();
+
+    return deletedIds;
+}
+
+/*! Returns the content hash (XXH64 of the serialized properties) of the object as hex
+ * ************************************************************************************************/
+QString QSRepositoryCpp::getContentHash(const QString &uuidStr)
+{
+    updateContentHashes();
+
+    const auto &bucket = m_contentHashes.at(digestBucket(uuidStr));
+    const auto  it     = bucket.constFind(uuidStr);
+
+    return it != bucket.constEnd() ? HashStringCPP::toHex64(it.value()) : QString();
+}
+
+/*! Returns whether the content of the object differs from the last persisted state. Objects whose
+ *  properties were changed back (or set to an identical value) are not considered changed.
+ * ************************************************************************************************/
+bool QSRepositoryCpp::isObjectChanged(const QString &uuidStr)
+{
+    updateContentHashes();
+
+    const auto &bucket = m_contentHashes.at(digestBucket(uuidStr));
+    const auto  it     = bucket.constFind(uuidStr);
+
+    // Sanity check: unknown objects are unchanged
+    if (it == bucket.constEnd()) { return false; }
+
+    const auto persistedIt = m_persistedHashes.constFind(uuidStr);
+
+    return persistedIt == m_persistedHashes.constEnd() || persistedIt.value() != it.value();
+}
+
+/*! Returns all objects whose content differs from the last persisted state (including new ones)
+ * ************************************************************************************************/
+QStringList QSRepositoryCpp::getChangedObjectIds()
+{
+    QStringList changedIds;
+
+    updateContentHashes();
+
+    for (const QHash<QString, quint64> &bucket : std::as_const(m_contentHashes)) {
+        for (auto it = bucket.cbegin(); it != bucket.cend(); ++it) {
+            const auto persistedIt = m_persistedHashes.constFind(it.key());
+
+            if (persistedIt == m_persistedHashes.constEnd() || persistedIt.value() != it.value()) {
+                changedIds.append(it.key());
+            }
+        }
+    }
+
+    return changedIds;
+}
+
+/*! Stores the current content hashes of the objects (all if empty) as persisted state, e.g., after
+ *  saving or loading. Persisted hashes of objects that are neither loaded nor paged out are dropped.
+ * ************************************************************************************************/
+void QSRepositoryCpp::markPersisted(const QStringList &uuidStrs)
+{
+    updateContentHashes();
+
+    if (!uuidStrs.isEmpty()) {
+        for (const QString &uuidStr : uuidStrs) {
+            const auto &bucket = m_contentHashes.at(digestBucket(uuidStr));
+            const auto  it     = bucket.constFind(uuidStr);
+
+            if (it != bucket.constEnd()) {
+                m_persistedHashes.insert(uuidStr, it.value());
+            }
+        }
+        return;
+    }
+
+    m_persistedHashes.removeIf([this](const QHash<QString, quint64>::iterator &it) {
+        return !m_pagedOutIds.contains(it.key());
+    });
+
+    for (const QHash<QString, quint64> &bucket : std::as_const(m_contentHashes)) {
+        m_persistedHashes.insert(bucket);
+    }
+}
+
+/*! Returns a digest of all loaded objects (XXH64 over the digest buckets) as hex. Equal digests
+ *  mean equal repos, see getDigestBuckets() to narrow down differences.
+ * ************************************************************************************************/
+QString QSRepositoryCpp::getRepoDigest()
+{
+    updateDigest();
+
+    return HashStringCPP::toHex64(m_repoDigest);
+}
+
+/*! Returns the hashes of the 256 digest buckets as hex, objects are assigned to buckets by UUID
+ * ************************************************************************************************/
+QStringList QSRepositoryCpp::getDigestBuckets()
+{
+    QStringList digestBuckets;
+
+    updateDigest();
+
+    digestBuckets.reserve(m_digestBuckets.size());
+    for (quint64 bucketHash : std::as_const(m_digestBuckets)) {
+        digestBuckets.append(HashStringCPP::toHex64(bucketHash));
+    }
+
+    return digestBuckets;
+}
+
+/*! Returns the estimated memory footprint of the loaded objects by qsType:
+ *
+ *      { "objects": 2, "totalBytes": 4242,
+ *        "types": { "Node": { "count": 2, "bytes": { ... }, "bytesPerInstance": { ... } } },
+ *        "totals": { "object": .., "properties": .., "bookkeeping": .., "connections": .., "total": .. },
+ *        "repository": { "undoHistory": .., "pagedOutIds": .., "digest": .., "total": .. } }
+ *
+ *  Bytes are split into the object itself (instance, QObject data and cached names), its
+ *  properties (as serialized), the bookkeeping of the repo (object map, indices, hashes, snapshot
+ *  cache, undo values) and the connections of observeObject().
+ *
+ * \note    Sizes are estimates based on the layout of Qt 6 on 64-bit platforms: shared data (e.g.,
+ *          implicitly shared strings or snapshots) is counted for every holder, and memory of the
+ *          QML engine (e.g., bindings) is not included
+ * ************************************************************************************************/
+QVariantMap QSRepositoryCpp::getMemoryReport()
+{
+    // Rough sizes of Qt internals
+    constexpr qint64 qobjectDataBytes   = 160;  // QObjectPrivate, incl. extra data
+    constexpr qint64 connectionBytes    = 96;   // QObjectPrivate::Connection and slot object
+    constexpr qint64 hashEntryBytes     = 16;   // Span overhead per QHash/QSet entry
+    constexpr qint64 mapEntryBytes      = 32;   // Tree node overhead per QMap entry
+
+    const auto stringBytes = [](const QString &str) -> qint64 {
+        return sizeof(QString) + (str.isNull() ? 0 : 16 + (str.capacity() + 1) * qint64(sizeof(QChar)));
+    };
+
+    struct Footprint {
+        qint64 count       = 0;
+        qint64 object      = 0;
+        qint64 properties  = 0;
+        qint64 bookkeeping = 0;
+        qint64 connections = 0;
+
+        qint64 total() const { return object + properties + bookkeeping + connections; }
+
+        void add(const Footprint &other) {
+            count       += other.count;
+            object      += other.object;
+            properties  += other.properties;
+            bookkeeping += other.bookkeeping;
+            connections += other.connections;
+        }
+
+        QVariantMap toMap(qint64 divisor = 1) const {
+            divisor = std::max<qint64>(divisor, 1);
+            return {
+                { "object",      object      / divisor },
+                { "properties",  properties  / divisor },
+                { "bookkeeping", bookkeeping / divisor },
+                { "connections", connections / divisor },
+                { "total",       total()     / divisor }
+            };
+        }
+    };
+
+    QHash<QString, Footprint> footprints;
+    Footprint                 totals;
+
+    for (auto it = m_objects.cbegin(); it != m_objects.cend(); ++it) {
+        QSObjectCpp *qsObject = it.value().value<QSObjectCpp*>();
+        if (qsObject == nullptr) { continue; }
+
+        const QString &uuidStr = it.key();
+        Footprint footprint;
+        footprint.count = 1;
+
+        // Instance, QObject data and the type names cached per object
+        footprint.object = qint64(sizeof(QSObjectCpp)) + qobjectDataBytes
+                         + stringBytes(qsObject->m_type)          - qint64(sizeof(QString))
+                         + stringBytes(qsObject->m_interfaceType) - qint64(sizeof(QString));
+
+        footprint.properties = QSSerializerCpp::estimateSize(QSSerializerCpp::getQSProps(qsObject));
+
+        // Object map and type index
+        footprint.bookkeeping = mapEntryBytes + stringBytes(uuidStr) + qint64(sizeof(QVariant))
+                              + hashEntryBytes + qint64(sizeof(QString) + sizeof(QSObjectCpp*));
+
+        // Property indices
+        for (const PropertyIndex &propertyIndex : std::as_const(m_propertyIndices)) {
+            const auto valueIt = propertyIndex.valueByUuid.constFind(uuidStr);
+            if (valueIt == propertyIndex.valueByUuid.constEnd()) { continue; }
+
+            footprint.bookkeeping += 2 * (hashEntryBytes + qint64(sizeof(QString)))
+                                   + qint64(sizeof(QByteArray)) + valueIt.value().size();
+        }
+
+        // References (by referrer and by target)
+        const QHash<QString, QStringList> references = m_references.value(uuidStr);
+        for (auto refIt = references.cbegin(); refIt != references.cend(); ++refIt) {
+            footprint.bookkeeping += hashEntryBytes + stringBytes(refIt.key())
+                                   + qint64(sizeof(QStringList))
+                                   + refIt.value().size() * qint64(sizeof(QString));
+        }
+        footprint.bookkeeping += m_referrers.value(uuidStr).size()
+                               * (hashEntryBytes + qint64(sizeof(QString) + sizeof(int)));
+
+        // Content hashes (current and persisted)
+        const qint64 hashBytes = hashEntryBytes + qint64(sizeof(QString) + sizeof(quint64));
+        if (m_contentHashes.value(digestBucket(uuidStr)).contains(uuidStr)) {
+            footprint.bookkeeping += hashBytes;
+        }
+        if (m_persistedHashes.contains(uuidStr)) {
+            footprint.bookkeeping += hashBytes;
+        }
+
+        // Snapshot cache and undo values
+        const QSRepositorySnapshot::ObjectData snapshotData = m_snapshotObjects.value(uuidStr);
+        if (!snapshotData.isNull()) {
+            footprint.bookkeeping += hashEntryBytes
+                                   + qint64(sizeof(QString) + sizeof(QSRepositorySnapshot::ObjectData))
+                                   + QSSerializerCpp::estimateSize(*snapshotData);
+        }
+        const qint64 capturedBytes = m_undoHistory->getObjectBytes(qsObject);
+        if (capturedBytes > 0) {
+            footprint.bookkeeping += hashEntryBytes + qint64(sizeof(void*)) + capturedBytes;
+        }
+
+        footprint.connections = countObservedSignals(qsObject) * connectionBytes;
+
+        footprints[qsObject->getType()].add(footprint);
+        totals.add(footprint);
+    }
+
+    // Memory of the repo that is not attributed to single objects
+    const qint64 undoHistoryBytes = m_undoHistory->getUsedBytes();
+    const qint64 pagedOutBytes    = m_pagedOutIds.size()
+                                  * (hashEntryBytes + stringBytes(QUuid().toString()));
+    const qint64 digestBytes      = m_digestBuckets.size() * qint64(sizeof(quint64));
+
+    QVariantMap types;
+    for (auto it = footprints.cbegin(); it != footprints.cend(); ++it) {
+        types.insert(it.key(), QVariantMap {
+            { "count",            it->count },
+            { "bytes",            it->toMap() },
+            { "bytesPerInstance", it->toMap(it->count) }
+        });
+    }
+
+    const qint64 repositoryBytes = undoHistoryBytes + pagedOutBytes + digestBytes;
+
+    return {
+        { "objects",    totals.count },
+        { "types",      types },
+        { "totals",     totals.toMap() },
+        { "repository", QVariantMap {
+              { "undoHistory", undoHistoryBytes },
+              { "pagedOutIds", pagedOutBytes },
+              { "digest",      digestBytes },
+              { "total",       repositoryBytes } } },
+        { "totalBytes", totals.total() + repositoryBytes }
+    };
+}
+
+/*! Returns getMemoryReport() as indented JSON, e.g., for logging
+ * ************************************************************************************************/
+QString QSRepositoryCpp::getMemoryReportJson()
+{
+    return QString::fromUtf8(QJsonDocument(QJsonObject::fromVariantMap(getMemoryReport()))
+                                 .toJson(QJsonDocument::Indented));
+}
+
+/* ************************************************************************************************
+ * Protected Slots
+ * ************************************************************************************************/
+/*! Adds an QSObject to the repository
+ * ************************************************************************************************/
+bool QSRepositoryCpp::addObject(const QString &uuidStr, QSObjectCpp *qsObject, bool force)
+{
+    // Sanity check: skip if already added
+    if (m_objects.contains(uuidStr)) {
+        // If forced, unobserve old object
+        if (force) {
+            QSObjectCpp *oldObject = m_objects[uuidStr].value<QSObjectCpp*>();
+            unobserveObject(oldObject);
+            unindexObject(uuidStr, oldObject);
+            m_undoHistory->releaseObject(oldObject);
+
+            // Record replaced object for rollback
+            if (m_batchDepth > 0 && oldObject != qsObject) {
+                recordBatchDel(uuidStr, oldObject);
+            }
+        } else {
+            qWarning() << "Skipped adding object" << uuidStr << "-- uuid already registered!";
+            return false;
+        }
+    }
+
+    // Remove from deleted objects if rquired
+    m_deletedObjects.remove(uuidStr);
+
+    // Add to local administration
+    m_objects[uuidStr] = QVariant::fromValue(qsObject);
+    m_pagedOutIds.remove(uuidStr);
+    markDirty(uuidStr);
+    ++m_revision;
+
+    // Start listening to changes on object (local only)
+    observeObject(qsObject);
+    indexObject(uuidStr, qsObject);
+    m_undoHistory->recordAdded(uuidStr, qsObject);
+    m_recorder->recordAdded(uuidStr, qsObject);
+
+    // Defer notifications when batching
+    if (m_batchDepth > 0) {
+        recordBatchAdd(uuidStr, qsObject);
+    } else {
+        emit objectAdded(qsObject);
+
+        if (!m_isLoading) {
+            emit objectsChanged();
+        }
+    }
+
+    // Record added object
+    if (m_addedObjects.append(qsObject, QVariant::fromValue(qsObject))) {
+        if (!(m_isLoading || m_batchDepth > 0)) {
+            emit addedObjectsChanged();
+        }
+    }
+
+    return true;
+}
+
+/*! Removes all QSObjects from the repository (see delObjects())
+ * ************************************************************************************************/
+bool QSRepositoryCpp::clearObjects()
+{
+    // Sanity check: skip if nothing to be done
+    if (m_objects.empty()) { return false; }
+
+    return delObjects(m_objects.keys());
+}
+
+/*! Removes an QSObject from the repository (by UUID)
+ * ************************************************************************************************/
+bool QSRepositoryCpp::delObject(const QString &uuidStr, bool suppressSignal)
+{
+    // Sanity check: skip if already added
+    if (!m_objects.contains(uuidStr)) { return false; }
+
+    markDirty(uuidStr);
+    ++m_revision;
+
+    // Remove the objet and disconnect all signals if we can find the object
+    if (QSObjectCpp *qsObject = m_objects.take(uuidStr).value<QSObjectCpp*>()) {
+        unobserveObject(qsObject);
+        unindexObject(uuidStr, qsObject);
+        m_undoHistory->recordDeleted(uuidStr, qsObject);
+        m_recorder->recordDeleted(uuidStr);
+
+        // Remove from pending changes
+        // \note No signals emitted as the system should alreay have been triggered when added/updated
+        m_addedObjects.remove(qsObject);
+        m_updatedObjects.remove(qsObject);
+
+        // Defer notification when batching
+        if (m_batchDepth > 0) {
+            recordBatchDel(uuidStr, qsObject);
+        } else {
+            emit objectDeleted(qsObject->getUuidStr());
+        }
+    }
+
+    if (!(m_isLoading || suppressSignal || m_batchDepth > 0)) {
+        emit objectsChanged();
+    }
+
+    // Record deleted uuid
+    if (m_deletedObjects.append(uuidStr, uuidStr)) {
+        if (!(m_isLoading || suppressSignal || m_batchDepth > 0)) {
+            emit deletedObjectsChanged();
+        }
+    }
+
+    return true;
+}
+
+/*! Removes multiple QSObjects from the repository in a single pass. Observers are informed by a
+ *  single objectsDeleted() (objectDeleted() for a single object, deferred when batching).
+ * ************************************************************************************************/
+bool QSRepositoryCpp::delObjects(const QStringList &uuidStrs)
+{
+    QStringList deletedIds;
+
+    deletedIds.reserve(uuidStrs.size());
+
+    for (const QString &uuidStr : uuidStrs) {
+        auto it = m_objects.find(uuidStr);
+
+        // Sanity check: skip unknown (or already deleted) objects
+        if (it == m_objects.end()) { continue; }
+
+        QSObjectCpp *qsObject = it.value().value<QSObjectCpp*>();
+        m_objects.erase(it);
+
+        if (qsObject != nullptr) {
+            unobserveObject(qsObject);
+            unindexObject(uuidStr, qsObject);
+            m_undoHistory->recordDeleted(uuidStr, qsObject);
+            m_recorder->recordDeleted(uuidStr);
+
+            // Remove from pending changes
+            // \note No signals emitted as the system should alreay have been triggered when added/updated
+            m_addedObjects.remove(qsObject);
+            m_updatedObjects.remove(qsObject);
+
+            if (m_batchDepth > 0) {
+                recordBatchDel(uuidStr, qsObject);
+            }
+        }
+
+        markDirty(uuidStr);
+        deletedIds.append(uuidStr);
+
+        // Record deleted uuid
+        m_deletedObjects.append(uuidStr, uuidStr);
+    }
+
+    // Sanity check: nothing was deleted
+    if (deletedIds.isEmpty()) { return false; }
+
+    ++m_revision;
+
+    // Inform observers (deferred when batching)
+    if (m_batchDepth == 0) {
+        emitObjectsDeleted(deletedIds);
+
+        if (!m_isLoading) {
+            emit objectsChanged();
+            emit deletedObjectsChanged();
+        }
+    }
+
+    return true;
+}
+
+/*! Relays the net changes of forwarded repos at once, as a batch would (see commitBatch())
+ * ************************************************************************************************/
+void QSRepositoryCpp::flushForwardedChanges()
+{
+    m_forwardedFlushScheduled = false;
+
+    const QStringList deletedIds = std::exchange(m_forwardedDeletedPending, QSet<QString>()).values();
+
+    // Objects destroyed since they were added are skipped
+    QVariantList addedObjects;
+    addedObjects.reserve(m_forwardedAddedPending.size());
+    for (const QPointer<QSObjectCpp> &qsObject : std::as_const(m_forwardedAddedPending)) {
+        if (!qsObject.isNull()) {
+            addedObjects.append(QVariant::fromValue(qsObject.data()));
+        }
+    }
+    m_forwardedAddedPending.clear();
+
+    if (deletedIds.isEmpty() && addedObjects.isEmpty()) { return; }
+
+    emitObjectsDeleted(deletedIds);
+    emitObjectsAdded(addedObjects);
+
+    emit objectsChanged();
+}
+
+/*! Makes all QSObjects in the repository unavailable when repo becomes unavailable. A re-sync of
+ *  object availability will need to make these available again -- that way we prevent recently
+ *  removed objects from appearing available after a reconnect, while they are not.
+ * ************************************************************************************************/
+void QSRepositoryCpp::onIsAvailableChanged()
+{
+    if (!getIsAvailable()) {
+        for (QVariant &var : m_objects) {
+            if (QSObjectCpp *qsObject = var.value<QSObjectCpp*>()) {
+                qsObject->setIsAvailable(false);
+            }
+        }
+    }
+}
+
+void QSRepositoryCpp::onObjectChanged()
+{
+    const QSObjectCpp *qsObject = qobject_cast<QSObjectCpp*>(sender());
+
+    handleObjectChanged(sender(), qsObject != nullptr
+                                ? QSSerializerCpp::propertyIndexForSignal(qsObject->metaObject(),
+                                                                          senderSignalIndex())
+                                : -1);
+}
+
+/* Private Functions
+ * ************************************************************************************************/
+/*! Schedules relaying of forwarded changes (once per event loop iteration)
+ * ************************************************************************************************/
+void QSRepositoryCpp::scheduleForwardedFlush()
+{
+    if (m_forwardedFlushScheduled) { return; }
+
+    m_forwardedFlushScheduled = true;
+    QMetaObject::invokeMethod(this, &QSRepositoryCpp::flushForwardedChanges, Qt::QueuedConnection);
+}
+
+/*! Connects to all object Changed() signals, exluding 'private' properties starting with _ and
+ *  properties of derived classes if an interface is used (see QSSchema for types with a schema)
+ * ************************************************************************************************/
+void QSRepositoryCpp::observeObject(QSObjectCpp *qsObject)
+{
+    // Cache targeted slot: QSRepositoryCpp::onObjectChanged()
+    static const QMetaMethod metaOnObjectChanged =
+        metaObject()->method(QSRepositoryCpp::staticMetaObject.indexOfSlot("onObjectChanged()"));
+
+    // Types with a schema connect their signals directly (with known property indices)
+    const QSSchemaRegistry::Entry schema = QSSchemaRegistry::find(qsObject->metaObject());
+    if (schema.isValid() && qsObject->getInterfaceMetaObject() == nullptr) {
+        schema.observe(qsObject, this, [](QObject *receiver, QObject *object, int propertyIndex) {
+            static_cast<QSRepositoryCpp*>(receiver)->handleObjectChanged(object, propertyIndex);
+        });
+        return;
+    }
+
+    // Connect all Changed() signals of qsObject by iterating over all its superclasses
+    const QMetaObject* metaObject = qsObject->metaObject();
+
+    // Limit observation of properties to most specific interface (if applicable)
+    int lastMethod = qsObject->getInterfaceMetaObject() != nullptr
+                   ? qsObject->getInterfaceMetaObject()->methodCount()
+                   : metaObject->methodCount();
+
+    // Observe all propChanged() signals
+    for(int i = 0; i < lastMethod; ++i) {
+        const QMetaMethod metaMethod = metaObject->method(i);
+
+        if (isObservedSignal(metaMethod))
+        {
+            connect(qsObject, metaMethod, this, metaOnObjectChanged);
+//            qDebug() << "CONNECTED " << metaObject->className() << metaMethod.name();
+        }
+    }
+}
+
+/*! Disconnects all signals between object and this repo
+ * ************************************************************************************************/
+void QSRepositoryCpp::unobserveObject(QSObjectCpp *qsObject)
+{
+    disconnect(qsObject, nullptr, this, nullptr);
+}
+
+/*! Returns the number of signals of the object connected by observeObject()
+ * ************************************************************************************************/
+int QSRepositoryCpp::countObservedSignals(QSObjectCpp *qsObject) const
+{
+    const QSSchemaRegistry::Entry schema = QSSchemaRegistry::find(qsObject->metaObject());
+    if (schema.isValid() && qsObject->getInterfaceMetaObject() == nullptr) {
+        return schema.signalCount;
+    }
+
+    const QMetaObject* metaObject = qsObject->metaObject();
+    int lastMethod = qsObject->getInterfaceMetaObject() != nullptr
+                   ? qsObject->getInterfaceMetaObject()->methodCount()
+                   : metaObject->methodCount();
+
+    int signalCount = 0;
+    for (int i = 0; i < lastMethod; ++i) {
+        if (isObservedSignal(metaObject->method(i))) { ++signalCount; }
+    }
+
+    return signalCount;
+}
+
+/*! Returns whether the signal is connected by observeObject(): propChanged() signals, excluding
+ *  'private' ones starting with _
+ * ************************************************************************************************/
+bool QSRepositoryCpp::isObservedSignal(const QMetaMethod &metaMethod)
+{
+    return metaMethod.methodType() == QMetaMethod::Signal
+        && !metaMethod.name().startsWith("_")
+        && metaMethod.name().endsWith("Changed");
+}
+
+/*! Informs observers about added objects: objectAdded() for a single object, otherwise a single
+ *  objectsAdded() without per-object signals
+ * ************************************************************************************************/
+void QSRepositoryCpp::emitObjectsAdded(const QVariantList &qsObjects)
+{
+    if (qsObjects.size() == 1) {
+        emit objectAdded(qsObjects.first().value<QSObjectCpp*>());
+    } else if (!qsObjects.isEmpty()) {
+        emit objectsAdded(qsObjects);
+    }
+}
+
+/*! Informs observers about deleted objects: objectDeleted() for a single object, otherwise a single
+ *  objectsDeleted() without per-object signals
+ * ************************************************************************************************/
+void QSRepositoryCpp::emitObjectsDeleted(const QStringList &uuidStrs)
+{
+    if (uuidStrs.size() == 1) {
+        emit objectDeleted(uuidStrs.first());
+    } else if (!uuidStrs.isEmpty()) {
+        emit objectsDeleted(uuidStrs);
+    }
+}
+
+/*! Queues the addition of an object of a forwarded repo
+ * ************************************************************************************************/
+void QSRepositoryCpp::recordForwardedAdd(const QString &uuidStr, QSObjectCpp *qsObject)
+{
+    m_forwardedAddedPending.insert(uuidStr, qsObject);
+    scheduleForwardedFlush();
+}
+
+/*! Queues the deletion of an object of a forwarded repo. Deleting an object that was added since the
+ *  last flush cancels out, so observers never see objects that no longer exist.
+ * ************************************************************************************************/
+void QSRepositoryCpp::recordForwardedDel(const QString &uuidStr)
+{
+    if (m_forwardedAddedPending.remove(uuidStr) > 0) { return; }
+
+    m_forwardedDeletedPending.insert(uuidStr);
+    scheduleForwardedFlush();
+}
+
+/*! Records the net addition of an object during a batch
+ * ************************************************************************************************/
+void QSRepositoryCpp::recordBatchAdd(const QString &uuidStr, QSObjectCpp *qsObject)
+{
+    // Re-adding an object deleted in this batch cancels out
+    auto deletedIt = m_batchDeletedObjects.find(uuidStr);
+    if (deletedIt != m_batchDeletedObjects.end() && deletedIt.value() == qsObject) {
+        m_batchDeletedObjects.erase(deletedIt);
+        return;
+    }
+
+    m_batchAddedObjects.insert(uuidStr, qsObject);
+}
+
+/*! Records the net deletion of an object during a batch
+ * ************************************************************************************************/
+void QSRepositoryCpp::recordBatchDel(const QString &uuidStr, QSObjectCpp *qsObject)
+{
+    // Deleting an object added in this batch cancels out
+    if (m_batchAddedObjects.remove(uuidStr) > 0) { return; }
+
+    // Only remember the object that existed before the batch
+    if (!m_batchDeletedObjects.contains(uuidStr)) {
+        m_batchDeletedObjects.insert(uuidStr, qsObject);
+    }
+}
+
+/*! Clears the batch administration
+ * ************************************************************************************************/
+void QSRepositoryCpp::resetBatch()
+{
+    m_batchAddedObjects.clear();
+    m_batchDeletedObjects.clear();
+    m_batchAddedBackup   = {};
+    m_batchDeletedBackup = {};
+    m_batchUpdated = false;
+}
+
+/*! Adds the object to the type index and all property indices
+ * ************************************************************************************************/
+void QSRepositoryCpp::indexObject(const QString &uuidStr, QSObjectCpp *qsObject)
+{
+    // Sanity check
+    if (qsObject == nullptr) { return; }
+
+    m_typeIndex[qsObject->getType()].insert(uuidStr, qsObject);
+
+    for (auto it = m_propertyIndices.keyBegin(); it != m_propertyIndices.keyEnd(); ++it) {
+        indexProperty(*it, uuidStr, qsObject);
+    }
+
+    // References of loaded objects are indexed once their URLs are resolved
+    if (!m_isLoading) {
+        indexReferences(uuidStr, qsObject);
+    }
+}
+
+/*! Removes the object from the type index and all property indices
+ * ************************************************************************************************/
+void QSRepositoryCpp::unindexObject(const QString &uuidStr, QSObjectCpp *qsObject)
+{
+    // Sanity check
+    if (qsObject == nullptr) { return; }
+
+    auto typeIt = m_typeIndex.find(qsObject->getType());
+    if (typeIt != m_typeIndex.end() && typeIt->value(uuidStr) == qsObject) {
+        typeIt->remove(uuidStr);
+
+        if (typeIt->isEmpty()) { m_typeIndex.erase(typeIt); }
+    }
+
+    for (PropertyIndex &propertyIndex : m_propertyIndices) {
+        auto valueIt = propertyIndex.valueByUuid.find(uuidStr);
+        if (valueIt == propertyIndex.valueByUuid.end()) { continue; }
+
+        auto uuidsIt = propertyIndex.uuidsByValue.find(valueIt.value());
+        if (uuidsIt != propertyIndex.uuidsByValue.end()) {
+            uuidsIt->remove(uuidStr);
+
+            if (uuidsIt->isEmpty()) { propertyIndex.uuidsByValue.erase(uuidsIt); }
+        }
+
+        propertyIndex.valueByUuid.erase(valueIt);
+    }
+
+    unindexReferences(uuidStr);
+}
+
+/*! Moves the object to the entry of its current value in the index of propName
+ * ************************************************************************************************/
+void QSRepositoryCpp::indexProperty(const QString &propName, const QString &uuidStr,
+                                    QSObjectCpp *qsObject)
+{
+    auto indexIt = m_propertyIndices.find(propName);
+
+    // Sanity check
+    if (qsObject == nullptr || indexIt == m_propertyIndices.end()) { return; }
+
+    PropertyIndex &propertyIndex = indexIt.value();
+
+    const QVariant   propValue = qsObject->property(propName.toLatin1().constData());
+    const QByteArray valueKey  = propValue.isValid()
+                               ? QSSerializerCpp::toCompactJson(QSSerializerCpp::getQSProp(propValue))
+                               : QByteArray();
+
+    // Remove old entry
+    auto valueIt = propertyIndex.valueByUuid.find(uuidStr);
+    if (valueIt != propertyIndex.valueByUuid.end()) {
+        if (valueIt.value() == valueKey) { return; }
+
+        auto uuidsIt = propertyIndex.uuidsByValue.find(valueIt.value());
+        if (uuidsIt != propertyIndex.uuidsByValue.end()) {
+            uuidsIt->remove(uuidStr);
+
+            if (uuidsIt->isEmpty()) { propertyIndex.uuidsByValue.erase(uuidsIt); }
+        }
+
+        propertyIndex.valueByUuid.erase(valueIt);
+    }
+
+    // Objects without the property are not indexed
+    if (!propValue.isValid()) { return; }
+
+    propertyIndex.valueByUuid.insert(uuidStr, valueKey);
+    propertyIndex.uuidsByValue[valueKey].insert(uuidStr);
+}
+
+/*! Indexes the references held by propName (or all serialized properties if empty). References
+ *  are collected from the property values directly, without serializing them.
+ * ************************************************************************************************/
+void QSRepositoryCpp::indexReferences(const QString &uuidStr, QSObjectCpp *qsObject,
+                                      const QString &propName)
+{
+    // Sanity check
+    if (qsObject == nullptr) { return; }
+
+    const QMetaObject *metaObject = qsObject->metaObject();
+
+    const auto indexMetaProperty = [&](const QMetaProperty &metaProperty) {
+        if (QSSerializerCpp::isPropertyBlackListed(metaProperty.name())) { return; }
+
+        QStringList targetIds;
+        QSSerializerCpp::collectReferences(metaProperty.read(qsObject), targetIds);
+
+        setReferences(uuidStr, QString::fromLatin1(metaProperty.name()), targetIds);
+    };
+
+    if (!propName.isEmpty()) {
+        const int propertyIndex = metaObject->indexOfProperty(propName.toLatin1().constData());
+
+        if (propertyIndex >= 0) { indexMetaProperty(metaObject->property(propertyIndex)); }
+        return;
+    }
+
+    for (int i = 0; i < metaObject->propertyCount(); ++i) {
+        indexMetaProperty(metaObject->property(i));
+    }
+}
+
+/*! Removes all references held by the object (references to it are kept)
+ * ************************************************************************************************/
+void QSRepositoryCpp::unindexReferences(const QString &uuidStr)
+{
+    const QStringList propNames = m_references.value(uuidStr).keys();
+
+    for (const QString &propName : propNames) {
+        setReferences(uuidStr, propName, QStringList());
+    }
+}
+
+/*! Replaces the targets referenced by propName of the object and updates the reverse index
+ * ************************************************************************************************/
+void QSRepositoryCpp::setReferences(const QString &uuidStr, const QString &propName,
+                                    const QStringList &targetIds)
+{
+    auto referrerIt = m_references.find(uuidStr);
+
+    const QStringList oldTargetIds = referrerIt != m_references.end()
+                                   ? referrerIt->value(propName)
+                                   : QStringList();
+
+    // Sanity check: nothing to be done
+    if (oldTargetIds == targetIds) { return; }
+
+    // Release old targets
+    for (const QString &targetId : oldTargetIds) {
+        auto targetIt = m_referrers.find(targetId);
+        if (targetIt == m_referrers.end()) { continue; }
+
+        if (--(*targetIt)[uuidStr] <= 0) {
+            targetIt->remove(uuidStr);
+
+            if (targetIt->isEmpty()) { m_referrers.erase(targetIt); }
+        }
+    }
+
+    // Add new targets
+    for (const QString &targetId : targetIds) {
+        ++m_referrers[targetId][uuidStr];
+    }
+
+    // Write barrier of a running collection
+    if (m_collector->isRunning()) {
+        m_collector->shade(targetIds);
+    }
+
+    // Update administration, dropping empty entries
+    if (!targetIds.isEmpty()) {
+        m_references[uuidStr].insert(propName, targetIds);
+    } else if (referrerIt != m_references.end()) {
+        referrerIt->remove(propName);
+
+        if (referrerIt->isEmpty()) { m_references.erase(referrerIt); }
+    }
+}
+
+/*! Invalidates the cached serialized state (snapshot, content hash) of the object
+ * ************************************************************************************************/
+void QSRepositoryCpp::markDirty(const QString &uuidStr)
+{
+    m_snapshotDirtyIds.insert(uuidStr);
+    m_hashDirtyIds.insert(uuidStr);
+}
+
+/*! Re-hashes all objects that changed since the last call. The serialized properties are shared with
+ *  the snapshot cache, so objects are serialized at most once per change.
+ * ************************************************************************************************/
+void QSRepositoryCpp::updateContentHashes()
+{
+    for (const QString &uuidStr : std::as_const(m_hashDirtyIds)) {
+        const int    bucketIndex = digestBucket(uuidStr);
+        QSObjectCpp *qsObject    = m_objects.value(uuidStr).value<QSObjectCpp*>();
+
+        m_digestDirtyBuckets.insert(bucketIndex);
+
+        if (qsObject == nullptr) {
+            m_contentHashes[bucketIndex].remove(uuidStr);
+            continue;
+        }
+
+        const QVariantMap qsProps = getStorageProps(qsObject);
+        m_contentHashes[bucketIndex].insert(uuidStr, HashStringCPP::hash64(
+                                                         QSSerializerCpp::toCompactJson(qsProps)));
+
+        if (m_snapshotDirtyIds.remove(uuidStr)) {
+            m_snapshotObjects.insert(uuidStr, QSRepositorySnapshot::ObjectData::create(qsProps));
+        }
+    }
+
+    m_hashDirtyIds.clear();
+}
+
+/*! Recomputes the hashes of all buckets with changed objects, and the repo digest
+ * ************************************************************************************************/
+void QSRepositoryCpp::updateDigest()
+{
+    updateContentHashes();
+
+    // Sanity check: nothing changed
+    if (m_digestDirtyBuckets.isEmpty()) { return; }
+
+    for (int bucketIndex : std::as_const(m_digestDirtyBuckets)) {
+        const QHash<QString, quint64> &bucket = m_contentHashes.at(bucketIndex);
+
+        // Hash (UUID, content hash) pairs in a stable order
+        QStringList uuidStrs = bucket.keys();
+        uuidStrs.sort();
+
+        QByteArray data;
+        for (const QString &uuidStr : std::as_const(uuidStrs)) {
+            data.append(uuidStr.toLatin1());
+            data.append(HashStringCPP::toHex64(bucket.value(uuidStr)).toLatin1());
+        }
+
+        m_digestBuckets[bucketIndex] = uuidStrs.isEmpty() ? 0 : HashStringCPP::hash64(data);
+    }
+    m_digestDirtyBuckets.clear();
+
+    QByteArray data;
+    for (quint64 bucketHash : std::as_const(m_digestBuckets)) {
+        data.append(HashStringCPP::toHex64(bucketHash).toLatin1());
+    }
+
+    m_repoDigest = HashStringCPP::hash64(data);
+}
+
+/*! Returns the properties of qsObject as they are saved to disk. Repos with a storageProps()
+ *  function (QSRepository.qml) serialize through QML, others use the native serializer.
+ * ************************************************************************************************/
+QVariantMap QSRepositoryCpp::getStorageProps(QSObjectCpp *qsObject)
+{
+    // Resolve the QML function once (the final type is known by the time objects are serialized)
+    if (m_storagePropsMethod == -2) {
+        m_storagePropsMethod = metaObject()->indexOfMethod("storageProps(QVariant)");
+    }
+
+    if (m_storagePropsMethod < 0) { return QSSerializerCpp::getQSProps(qsObject); }
+
+    QVariant qsProps;
+    metaObject()->method(m_storagePropsMethod).invoke(this, Qt::DirectConnection,
+                                                      Q_RETURN_ARG(QVariant, qsProps),
+                                                      Q_ARG(QVariant, QVariant::fromValue(qsObject)));
+
+    return qsProps.metaType() == QMetaType::fromType<QJSValue>()
+           ? qsProps.value<QJSValue>().toVariant().toMap()
+           : qsProps.toMap();
+}
+
+/*! Returns the digest bucket of an object (first byte of the UUID's hash, stable across processes)
+ * ************************************************************************************************/
+int QSRepositoryCpp::digestBucket(const QString &uuidStr)
+{
+    return int(HashStringCPP::hash64(uuidStr.toLatin1()) >> 56);
+}
+
+/*! Updates all administration of a changed object (propertyIndex -1 means unknown property)
+ * ************************************************************************************************/
+void QSRepositoryCpp::handleObjectChanged(QObject *object, int propertyIndex)
+{
+    // Invalidate serialized state of the object
+    if (QSObjectCpp *qsObject = qobject_cast<QSObjectCpp*>(object)) {
+        const QString uuidStr = qsObject->getUuidStr();
+        markDirty(uuidStr);
+        ++m_revision;
+
+        const QString propName      = propertyIndex >= 0
+                                    ? QString::fromLatin1(
+                                          qsObject->metaObject()->property(propertyIndex).name())
+                                    : QString();
+
+        // Record property change for undo
+        if (m_undoHistory->isEnabled()) {
+            m_undoHistory->recordChanged(qsObject, propertyIndex);
+        }
+
+        // Record property change for replay
+        if (m_recorder->isRecording()) {
+            m_recorder->recordChanged(qsObject, propertyIndex);
+        }
+
+        // Update references of the property (or all if property is unknown), done by
+        // updateReferences() once URLs are resolved when loading
+        if (!m_isLoading) {
+            indexReferences(uuidStr, qsObject, propName);
+        }
+
+        // Update value index of the property (or all indices if property is unknown)
+        if (!m_propertyIndices.isEmpty()) {
+            if (!propName.isEmpty()) {
+                if (m_propertyIndices.contains(propName)) {
+                    indexProperty(propName, uuidStr, qsObject);
+                }
+            } else {
+                for (auto it = m_propertyIndices.keyBegin(); it != m_propertyIndices.keyEnd(); ++it) {
+                    indexProperty(*it, uuidStr, qsObject);
+                }
+            }
+        }
+    }
+
+    // Store reference to updated object
+    if (m_updatedObjects.append(object, QVariant::fromValue(object))) {
+        if (m_batchDepth > 0) {
+            m_batchUpdated = true;
+        } else {
+            emit updatedObjectsChanged();
+        }
+    }
 }
@@ -0,0 +1,382 @@
+#include "QSRepositoryFile.h"
+#include "QSIndexedFileCpp.h"
+#include "QSSerializerCpp.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QSet>
+
+const QString QSRepositoryFile::rootKey         = QStringLiteral("root");
+const QString QSRepositoryFile::versionKey      = QStringLiteral("version");
+const QString QSRepositoryFile::applicationKey  = QStringLiteral("Application");
+
+namespace {
+
+//! Hash used for the application entry -- mirrors HashStringCPP::hexHashString()
+QString hexHashString(const QString &str)
+{
+    return QString::fromLatin1(QCryptographicHash::hash(str.toUtf8(), QCryptographicHash::Md5)
+                                   .toHex());
+}
+
+//! Collects the UUIDs of all qqs:/ references in value
+void collectReferences(const QJsonValue &value, QStringList &uuidStrs)
+{
+    switch (value.type()) {
+    case QJsonValue::String: {
+        const QString str = value.toString();
+        if (str.startsWith(QSSerializerCpp::protoString)) {
+            uuidStrs.append(str.mid(QSSerializerCpp::protoString.size()));
+        }
+        break;
+    }
+    case QJsonValue::Array:
+        for (const QJsonValue &item : value.toArray()) {
+            collectReferences(item, uuidStrs);
+        }
+        break;
+    case QJsonValue::Object: {
+        const QJsonObject object = value.toObject();
+        for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+            collectReferences(it.value(), uuidStrs);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+} // namespace
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+/*! Default constructor
+ * ************************************************************************************************/
+QSRepositoryFile::QSRepositoryFile()
+  : m_format    (Json)
+  , m_fileSize  (0)
+  , m_meta      ()
+  , m_objects   ()
+{
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+/*! Reads a JSON or indexed file (the format is detected)
+ * ************************************************************************************************/
+bool QSRepositoryFile::read(const QString &fileName, QString *errorString)
+{
+    const auto fail = [errorString](const QString &error) {
+        if (errorString != nullptr) { *errorString = error; }
+        return false;
+    };
+
+    m_format   = detectFormat(fileName);
+    m_fileSize = QFile(fileName).size();
+    m_meta.clear();
+    m_objects.clear();
+
+    // Indexed files: read all objects through the index
+    if (m_format == Indexed) {
+        QSIndexedFileCpp indexedFile;
+        if (!indexedFile.open(fileName)) { return fail(QStringLiteral("Invalid indexed file")); }
+
+        m_meta = indexedFile.meta();
+
+        const QStringList uuidStrs = indexedFile.objectIds();
+        m_objects.reserve(uuidStrs.size());
+        for (const QString &uuidStr : uuidStrs) {
+            const QJsonDocument objectDoc = QJsonDocument::fromJson(indexedFile.readRaw(uuidStr));
+
+            if (!objectDoc.isObject()) {
+                return fail(QStringLiteral("Invalid object %1").arg(uuidStr));
+            }
+
+            m_objects.insert(uuidStr, objectDoc.object());
+        }
+
+        return true;
+    }
+
+    // JSON files: objects are maps, all other entries are meta entries
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly)) { return fail(file.errorString()); }
+
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+
+    if (!doc.isObject()) {
+        return fail(parseError.error != QJsonParseError::NoError
+                    ? QStringLiteral("%1 at offset %2").arg(parseError.errorString())
+                                                       .arg(parseError.offset)
+                    : QStringLiteral("Not a repository file"));
+    }
+
+    const QJsonObject entries = doc.object();
+    m_objects.reserve(entries.size());
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        if (it.value().isObject()) {
+            m_objects.insert(it.key(), it.value().toObject());
+        } else {
+            m_meta.insert(it.key(), it.value().toVariant());
+        }
+    }
+
+    return true;
+}
+
+/*! Writes the repository in format (the file is replaced atomically)
+ * ************************************************************************************************/
+bool QSRepositoryFile::write(const QString &fileName, Format format) const
+{
+    if (format == Indexed) {
+        QHash<QString, QByteArray> objects;
+        objects.reserve(m_objects.size());
+
+        for (auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it) {
+            objects.insert(it.key(), QJsonDocument(it.value()).toJson(QJsonDocument::Compact));
+        }
+
+        return QSIndexedFileCpp::write(fileName, m_meta, objects);
+    }
+
+    // Same layout as QSRepository.saveToFile()
+    QJsonObject entries = QJsonObject::fromVariantMap(m_meta);
+    for (auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it) {
+        entries.insert(it.key(), it.value());
+    }
+
+    QSaveFile file(fileName);
+    if (!file.open(QFile::WriteOnly)) { return false; }
+
+    file.write(QJsonDocument(entries).toJson(QJsonDocument::Indented));
+
+    return file.commit();
+}
+
+QSRepositoryFile::Format QSRepositoryFile::format() const
+{
+    return m_format;
+}
+
+/*! Returns all non-object entries (root, version, application)
+ * ************************************************************************************************/
+QVariantMap QSRepositoryFile::meta() const
+{
+    return m_meta;
+}
+
+/*! Returns the UUID of the root object (empty if not set)
+ * ************************************************************************************************/
+QString QSRepositoryFile::rootId() const
+{
+    const QString rootUrl = m_meta.value(rootKey).toString();
+
+    return rootUrl.startsWith(QSSerializerCpp::protoString)
+         ? rootUrl.mid(QSSerializerCpp::protoString.size())
+         : QString();
+}
+
+QStringList QSRepositoryFile::objectIds() const
+{
+    return m_objects.keys();
+}
+
+QJsonObject QSRepositoryFile::object(const QString &uuidStr) const
+{
+    return m_objects.value(uuidStr);
+}
+
+/*! Validates the application and version entries, errors are appended to errors
+ *  -- mirrors QSRepository.checkFileHeader()
+ *
+ * \note    The application is only checked if applicationName is set, and the major version only
+ *          if version is set
+ * ************************************************************************************************/
+bool QSRepositoryFile::checkHeader(const QString &applicationName, const QString &version,
+                                   const QString &minimumVersion, QStringList &errors) const
+{
+    const qsizetype errorCount = errors.size();
+
+    const QString hashedAppName = m_meta.value(hexHashString(applicationKey)).toString();
+    if (!applicationName.isEmpty() && !hashedAppName.isEmpty()
+            && hashedAppName != hexHashString(applicationName)) {
+        errors.append(QStringLiteral("The file is unrelated to the application"));
+    }
+
+    if (!minimumVersion.isEmpty()) {
+        const QString savedVersion = m_meta.value(versionKey).toString();
+
+        if (savedVersion.isEmpty()) {
+            errors.append(QStringLiteral("The file has no version"));
+        } else if (!version.isEmpty() && !isApplicationVersion(savedVersion, version)) {
+            errors.append(QStringLiteral("The file is for a higher major version (%1)")
+                              .arg(savedVersion));
+        } else if (!isSupportedVersion(savedVersion, minimumVersion)) {
+            errors.append(QStringLiteral("The file is too old (%1), minimum supported version is %2")
+                              .arg(savedVersion, minimumVersion));
+        }
+    }
+
+    return errors.size() == errorCount;
+}
+
+/*! Returns the objects that cannot be reached from the root object by following references
+ * ************************************************************************************************/
+QStringList QSRepositoryFile::findUnreachable() const
+{
+    QSet<QString> markedIds;
+    QStringList   grayIds;
+
+    const QString rootIdStr = rootId();
+    if (m_objects.contains(rootIdStr)) {
+        markedIds.insert(rootIdStr);
+        grayIds.append(rootIdStr);
+    }
+
+    while (!grayIds.isEmpty()) {
+        const QStringList targetIds = referencedIds(grayIds.takeLast());
+
+        for (const QString &targetId : targetIds) {
+            if (m_objects.contains(targetId) && !markedIds.contains(targetId)) {
+                markedIds.insert(targetId);
+                grayIds.append(targetId);
+            }
+        }
+    }
+
+    QStringList unreachableIds;
+    for (auto it = m_objects.keyBegin(); it != m_objects.keyEnd(); ++it) {
+        if (!markedIds.contains(*it)) { unreachableIds.append(*it); }
+    }
+
+    return unreachableIds;
+}
+
+/*! Returns the referenced UUIDs that are not stored in the file
+ * ************************************************************************************************/
+QStringList QSRepositoryFile::findDangling() const
+{
+    QSet<QString> danglingIds;
+
+    for (auto it = m_objects.keyBegin(); it != m_objects.keyEnd(); ++it) {
+        const QStringList targetIds = referencedIds(*it);
+
+        for (const QString &targetId : targetIds) {
+            if (!m_objects.contains(targetId)) { danglingIds.insert(targetId); }
+        }
+    }
+
+    return danglingIds.values();
+}
+
+/*! Removes all unreachable objects and returns their UUIDs (nothing is removed without root)
+ * ************************************************************************************************/
+QStringList QSRepositoryFile::compact()
+{
+    // Sanity check
+    if (!m_objects.contains(rootId())) { return QStringList(); }
+
+    const QStringList unreachableIds = findUnreachable();
+    for (const QString &uuidStr : unreachableIds) {
+        m_objects.remove(uuidStr);
+    }
+
+    return unreachableIds;
+}
+
+/*! Returns statistics of the file (sizes, objects by qsType, reachability)
+ * ************************************************************************************************/
+QVariantMap QSRepositoryFile::statistics() const
+{
+    QVariantMap types;
+    qint64      referenceCount = 0;
+
+    for (auto it = m_objects.constBegin(); it != m_objects.constEnd(); ++it) {
+        const QString qsType = it.value().value(QStringLiteral("qsType")).toString();
+        types.insert(qsType, types.value(qsType).toInt() + 1);
+
+        referenceCount += referencedIds(it.key()).size();
+    }
+
+    return {
+        { QStringLiteral("format"),      m_format == Indexed ? QStringLiteral("indexed")
+                                                             : QStringLiteral("json") },
+        { QStringLiteral("fileSize"),    m_fileSize },
+        { QStringLiteral("version"),     m_meta.value(versionKey) },
+        { QStringLiteral("rootId"),      rootId() },
+        { QStringLiteral("objects"),     m_objects.size() },
+        { QStringLiteral("types"),       types },
+        { QStringLiteral("references"),  referenceCount },
+        { QStringLiteral("unreachable"), findUnreachable().size() },
+        { QStringLiteral("dangling"),    findDangling().size() }
+    };
+}
+
+/* ************************************************************************************************
+ * Public Static Functions
+ * ************************************************************************************************/
+QSRepositoryFile::Format QSRepositoryFile::detectFormat(const QString &fileName)
+{
+    return QSIndexedFileCpp::isIndexedFile(fileName) ? Indexed : Json;
+}
+
+/*! Converts a version string (major.minor.patch, each part <= 99) to a number
+ *  -- mirrors QSRepository.getVersionNumber()
+ * ************************************************************************************************/
+int QSRepositoryFile::versionNumber(const QString &version)
+{
+    const QStringList parts = version.split(QLatin1Char('.'));
+
+    int number = 0;
+    for (qsizetype i = 0; i < parts.size(); ++i) {
+        const int part = parts.at(i).toInt();
+
+        if (part > 99) {
+            qWarning() << "[QSRepoFile] version part should not be greater than 99";
+        }
+
+        number += part * (i == 0 ? 10000 : i == 1 ? 100 : 1);
+    }
+
+    return number;
+}
+
+/*! Returns whether the saved version is at least the minimum version
+ *  -- mirrors QSRepository.checkSupportedVersion()
+ * ************************************************************************************************/
+bool QSRepositoryFile::isSupportedVersion(const QString &savedVersion,
+                                          const QString &minimumVersion)
+{
+    return !savedVersion.isEmpty() && versionNumber(savedVersion) >= versionNumber(minimumVersion);
+}
+
+/*! Returns whether the major version of the saved version does not exceed the one of version
+ *  -- mirrors QSRepository.checkApplicationVersion() (comparing numbers, not strings)
+ * ************************************************************************************************/
+bool QSRepositoryFile::isApplicationVersion(const QString &savedVersion, const QString &version)
+{
+    return !savedVersion.isEmpty()
+        && version.section(QLatin1Char('.'), 0, 0).toInt()
+               >= savedVersion.section(QLatin1Char('.'), 0, 0).toInt();
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+/*! Returns the UUIDs referenced by the object
+ * ************************************************************************************************/
+QStringList QSRepositoryFile::referencedIds(const QString &uuidStr) const
+{
+    QStringList uuidStrs;
+    collectReferences(m_objects.value(uuidStr), uuidStrs);
+
+    return uuidStrs;
+}
@@ -0,0 +1,101 @@
+#include "QSRepositorySnapshot.h"
+#include "QSSerializerCpp.h"
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+/*! Default constructor, creates a null snapshot
+ * ************************************************************************************************/
+QSRepositorySnapshot::QSRepositorySnapshot()
+  : m_repoId    ()
+  , m_rootId    ()
+  , m_objects   ()
+  , m_revision  (0)
+{
+}
+
+/*! Creates a snapshot sharing the (immutable) object data with the repository
+ * ************************************************************************************************/
+QSRepositorySnapshot::QSRepositorySnapshot(const QString &repoId, const QString &rootId,
+                                           const ObjectMap &objects, quint64 revision)
+  : m_repoId    (repoId)
+  , m_rootId    (rootId)
+  , m_objects   (objects)
+  , m_revision  (revision)
+{
+}
+
+/* ************************************************************************************************
+ * Public Getters
+ * ************************************************************************************************/
+bool QSRepositorySnapshot::isNull() const
+{
+    return m_repoId.isNull();
+}
+
+QString QSRepositorySnapshot::getRepoId() const
+{
+    return m_repoId;
+}
+
+QString QSRepositorySnapshot::getRootId() const
+{
+    return m_rootId;
+}
+
+/*! Returns the repository revision this snapshot was taken at
+ * ************************************************************************************************/
+quint64 QSRepositorySnapshot::getRevision() const
+{
+    return m_revision;
+}
+
+qsizetype QSRepositorySnapshot::size() const
+{
+    return m_objects.size();
+}
+
+bool QSRepositorySnapshot::contains(const QString &uuidStr) const
+{
+    return m_objects.contains(uuidStr);
+}
+
+QStringList QSRepositorySnapshot::objectIds() const
+{
+    return m_objects.keys();
+}
+
+/*! Returns the serialized properties of the object, or an empty map if unknown
+ * ************************************************************************************************/
+QVariantMap QSRepositorySnapshot::object(const QString &uuidStr) const
+{
+    const ObjectData data = m_objects.value(uuidStr);
+
+    return data.isNull() ? QVariantMap() : *data;
+}
+
+QSRepositorySnapshot::ObjectData QSRepositorySnapshot::objectData(const QString &uuidStr) const
+{
+    return m_objects.value(uuidStr);
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+/*! Returns all objects in the same layout as QSRepository.dumpRepo() (without application and
+ *  version keys)
+ * ************************************************************************************************/
+QVariantMap QSRepositorySnapshot::dump(const QString &rootKey) const
+{
+    QVariantMap jsonObjects;
+
+    for (auto it = m_objects.cbegin(); it != m_objects.cend(); ++it) {
+        jsonObjects.insert(it.key(), *it.value());
+    }
+
+    jsonObjects.insert(rootKey, m_rootId.isEmpty()
+                                ? QVariant()
+                                : QVariant(QSSerializerCpp::protoString + m_rootId));
+
+    return jsonObjects;
+}
@@ -0,0 +1,68 @@
+#include "QSSchema.h"
+
+#include <QHash>
+#include <QMetaProperty>
+#include <QReadWriteLock>
+
+namespace {
+
+struct Registry
+{
+    QReadWriteLock                                          lock;
+    QHash<const QMetaObject*, QSSchemaRegistry::Entry>      entries;
+};
+
+Registry &registry()
+{
+    static Registry instance;
+
+    return instance;
+}
+
+} // namespace
+
+/* ************************************************************************************************
+ * Public Static Functions
+ * ************************************************************************************************/
+/*! Registers (or replaces) the generated functions of the type with metaObject
+ * ************************************************************************************************/
+void QSSchemaRegistry::registerEntry(const QMetaObject *metaObject, const Entry &entry)
+{
+    Registry &schemas = registry();
+    QWriteLocker locker(&schemas.lock);
+
+    schemas.entries.insert(metaObject, entry);
+}
+
+/*! Returns the generated functions for objects with metaObject (invalid if not registered)
+ * ************************************************************************************************/
+QSSchemaRegistry::Entry QSSchemaRegistry::find(const QMetaObject *metaObject)
+{
+    Registry &schemas = registry();
+    QReadLocker locker(&schemas.lock);
+
+    return schemas.entries.value(metaObject);
+}
+
+/*! Returns the serialized properties (see QSSerializerCpp::getQSProps()) that are neither fields
+ *  nor handled by the schema itself (qsType, qsIsAvailable)
+ * ************************************************************************************************/
+QStringList QSSchema::missingProperties(const QMetaObject *metaObject, const QStringList &fieldNames)
+{
+    QStringList missingPropNames;
+
+    for (int i = 0; i < metaObject->propertyCount(); ++i) {
+        const QMetaProperty metaProperty = metaObject->property(i);
+        const QString       propName     = QString::fromLatin1(metaProperty.name());
+
+        if (QSSerializerCpp::isPropertyBlackListed(metaProperty.name())
+                || propName == QLatin1String("qsType") || propName == QLatin1String("qsIsAvailable")
+                || fieldNames.contains(propName)) {
+            continue;
+        }
+
+        missingPropNames.append(propName);
+    }
+
+    return missingPropNames;
+}
@@ -0,0 +1,629 @@
+#include "QSSerializerCpp.h"
+#include "QSObjectCpp.h"
+#include "QSObjectListCpp.h"
+#include "QSRepositoryCpp.h"
+#include "QSSchema.h"
+#include "QSValueCodecs.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QJSValue>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMetaProperty>
+#include <QReadWriteLock>
+#include <QRectF>
+#include <QSizeF>
+
+#include <utility>
+
+const QString QSSerializerCpp::protoString = QStringLiteral("qqs:/");
+
+namespace {
+
+bool isNullValue(const QVariant &value)
+{
+    return !value.isValid() || value.isNull();
+}
+
+bool isNumericValue(const QVariant &value)
+{
+    switch (value.typeId()) {
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool isListValue(const QVariant &value)
+{
+    return value.typeId() == QMetaType::QVariantList || value.typeId() == QMetaType::QStringList;
+}
+
+bool isMapValue(const QVariant &value)
+{
+    return value.typeId() == QMetaType::QVariantMap || value.typeId() == QMetaType::QVariantHash;
+}
+
+//! Property indices by notify signal index, per type (see propertyIndexForSignal())
+struct SignalPropertyCache
+{
+    QReadWriteLock                          lock;
+    QHash<QByteArray, QHash<int, int>>      signalProperties;
+};
+
+SignalPropertyCache &signalPropertyCache()
+{
+    static SignalPropertyCache instance;
+
+    return instance;
+}
+
+} // namespace
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+/*! Default constructor (QML singleton)
+ * ************************************************************************************************/
+QSSerializerCpp::QSSerializerCpp(QObject *parent)
+  : QObject             {parent}
+  , m_enumPropNames     ()
+{
+}
+
+/* ************************************************************************************************
+ * Public Static Functions
+ * ************************************************************************************************/
+/*! Returns a map of all (non blacklisted) properties of object, in which QSObjects are replaced by
+ *  their QtQuickStream URL -- mirrors QSSerializer.getQSProps()
+ * ************************************************************************************************/
+QVariantMap QSSerializerCpp::getQSProps(const QObject *object)
+{
+    QVariantMap qsProps;
+
+    // Sanity check
+    if (object == nullptr) { return qsProps; }
+
+    const QMetaObject *metaObject = object->metaObject();
+
+    // Use generated functions of types with a schema
+    const QSSchemaRegistry::Entry schema = QSSchemaRegistry::find(metaObject);
+    if (schema.isValid()) { return schema.toQSProps(object); }
+
+    for (int i = 0; i < metaObject->propertyCount(); ++i) {
+        const QMetaProperty metaProperty = metaObject->property(i);
+
+        // Skip blacklisted properties
+        if (isPropertyBlackListed(metaProperty.name())) { continue; }
+
+        // Enums are tagged based on the property (the value is a plain int)
+        qsProps.insert(QString::fromLatin1(metaProperty.name()),
+                       metaProperty.isEnumType()
+                       ? QSValueCodecs::encodeEnum(metaProperty.enumerator(),
+                                                   metaProperty.read(object).toInt())
+                       : getQSProp(metaProperty.read(object)));
+    }
+
+    return qsProps;
+}
+
+/*! Replaces QSObjects by their QtQuickStream URL and converts QML/JS values into plain variants
+ *  -- mirrors QSSerializer.getQSProp()
+ * ************************************************************************************************/
+QVariant QSSerializerCpp::getQSProp(const QVariant &propValue)
+{
+    // Nothing to do for null, undefined, etc.
+    if (!propValue.isValid()) { return propValue; }
+
+    // Unwrap JS values (e.g., 'property var')
+    if (propValue.metaType() == QMetaType::fromType<QJSValue>()) {
+        return getQSProp(propValue.value<QJSValue>().toVariant());
+    }
+
+    // Replace QSObject by its URL if it's registered, otherwise recurse
+    if (propValue.metaType().flags().testFlag(QMetaType::PointerToQObject)) {
+        const QObject *object = propValue.value<QObject*>();
+
+        if (object == nullptr) { return QVariant(); }
+
+        // Object lists are stored as list of references
+        if (const QSObjectListCpp *qsList = qobject_cast<const QSObjectListCpp*>(object)) {
+            QVariantList qsUrls;
+            qsUrls.reserve(qsList->count());
+            for (const QSObjectCpp *element : qsList->elements()) {
+                qsUrls.append(getQSUrl(element));
+            }
+            return qsUrls;
+        }
+
+        return isRegisteredQSObject(object)
+                ? QVariant(getQSUrl(qobject_cast<const QSObjectCpp*>(object)))
+                : QVariant(getQSProps(object));
+    }
+
+    // Tag value types (vectors, dates, colors, ...)
+    const QVariant qsValue = QSValueCodecs::encode(propValue);
+    if (qsValue.isValid()) { return qsValue; }
+
+    switch (propValue.typeId()) {
+    // Handle arrays
+    case QMetaType::QVariantList: {
+        QVariantList qsList;
+        for (const QVariant &item : propValue.toList()) {
+            qsList.append(getQSProp(item));
+        }
+        return qsList;
+    }
+    // Handle property maps
+    case QMetaType::QVariantMap: {
+        QVariantMap qsMap = propValue.toMap();
+        for (auto it = qsMap.begin(); it != qsMap.end(); ++it) {
+            it.value() = getQSProp(it.value());
+        }
+        return qsMap;
+    }
+    default:
+        return propValue;
+    }
+}
+
+/*! Returns an object reference based on the url (qqs:/UUID)
+ * ************************************************************************************************/
+QString QSSerializerCpp::getQSUrl(const QSObjectCpp *qsObject)
+{
+    return qsObject != nullptr
+         ? protoString + qsObject->getUuidStr()
+         : QString();
+}
+
+/*! Returns whether the property should be de/serialized -- mirrors QSSerializer.qml
+ * ************************************************************************************************/
+bool QSSerializerCpp::isPropertyBlackListed(const QByteArray &propName)
+{
+    return propName.startsWith('_') || propName.endsWith('_')
+        || propName == "objectName"  || propName == "selectionModel";
+}
+
+/*! Returns whether the object is a QSObject registered with a repo (or is a repo itself)
+ * ************************************************************************************************/
+bool QSSerializerCpp::isRegisteredQSObject(const QObject *object)
+{
+    const QSObjectCpp *qsObject = qobject_cast<const QSObjectCpp*>(object);
+
+    return qsObject != nullptr
+        && (qsObject->getRepo() != nullptr || qobject_cast<const QSRepositoryCpp*>(qsObject));
+}
+
+/*! Appends the UUIDs of all QtQuickStream URLs found in a serialized value to uuidStrs
+ * ************************************************************************************************/
+void QSSerializerCpp::collectQSUrls(const QVariant &qsProp, QStringList &uuidStrs)
+{
+    switch (qsProp.typeId()) {
+    case QMetaType::QString: {
+        const QString str = qsProp.toString();
+        if (str.startsWith(protoString)) {
+            uuidStrs.append(str.mid(protoString.size()));
+        }
+        break;
+    }
+    case QMetaType::QVariantList:
+        for (const QVariant &item : qsProp.toList()) {
+            collectQSUrls(item, uuidStrs);
+        }
+        break;
+    case QMetaType::QVariantMap:
+        for (const QVariant &item : qsProp.toMap()) {
+            collectQSUrls(item, uuidStrs);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/*! Appends the UUIDs of all QSObjects referenced by a (non-serialized) property value to uuidStrs,
+ *  i.e., the UUIDs collectQSUrls() finds in getQSProp(propValue) without building the latter
+ * ************************************************************************************************/
+void QSSerializerCpp::collectReferences(const QVariant &propValue, QStringList &uuidStrs)
+{
+    // Unwrap JS values (e.g., 'property var')
+    if (propValue.metaType() == QMetaType::fromType<QJSValue>()) {
+        collectReferences(propValue.value<QJSValue>().toVariant(), uuidStrs);
+        return;
+    }
+
+    if (propValue.metaType().flags().testFlag(QMetaType::PointerToQObject)) {
+        const QObject *object = propValue.value<QObject*>();
+
+        if (object == nullptr) { return; }
+
+        if (const QSObjectListCpp *qsList = qobject_cast<const QSObjectListCpp*>(object)) {
+            for (const QSObjectCpp *element : qsList->elements()) {
+                uuidStrs.append(element->getUuidStr());
+            }
+            return;
+        }
+
+        if (isRegisteredQSObject(object)) {
+            uuidStrs.append(qobject_cast<const QSObjectCpp*>(object)->getUuidStr());
+            return;
+        }
+
+        // Unregistered objects are serialized inline
+        const QMetaObject *metaObject = object->metaObject();
+        for (int i = 0; i < metaObject->propertyCount(); ++i) {
+            const QMetaProperty metaProperty = metaObject->property(i);
+
+            if (!isPropertyBlackListed(metaProperty.name()) && !metaProperty.isEnumType()) {
+                collectReferences(metaProperty.read(object), uuidStrs);
+            }
+        }
+        return;
+    }
+
+    switch (propValue.typeId()) {
+    case QMetaType::QString:
+        collectQSUrls(propValue, uuidStrs);
+        break;
+    case QMetaType::QVariantList:
+        for (const QVariant &item : propValue.toList()) {
+            collectReferences(item, uuidStrs);
+        }
+        break;
+    case QMetaType::QVariantMap:
+        for (const QVariant &item : propValue.toMap()) {
+            collectReferences(item, uuidStrs);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/*! Returns propValue without references to target: the pointer itself becomes null, list items and
+ *  map entries holding target are removed, object lists (QSObjectListCpp) drop target in place
+ * ************************************************************************************************/
+QVariant QSSerializerCpp::removeReference(const QVariant &propValue, const QObject *target)
+{
+    // Unwrap JS values (e.g., 'property var')
+    if (propValue.metaType() == QMetaType::fromType<QJSValue>()) {
+        return removeReference(propValue.value<QJSValue>().toVariant(), target);
+    }
+
+    if (propValue.metaType().flags().testFlag(QMetaType::PointerToQObject)) {
+        // Object lists are modified in place (the list property itself stays the same)
+        if (QSObjectListCpp *qsList = qobject_cast<QSObjectListCpp*>(propValue.value<QObject*>())) {
+            qsList->removeReference(target);
+            return propValue;
+        }
+
+        return propValue.value<QObject*>() == target
+             ? QVariant::fromValue<QObject*>(nullptr)
+             : propValue;
+    }
+
+    const auto isTarget = [target](const QVariant &item) {
+        return item.metaType().flags().testFlag(QMetaType::PointerToQObject)
+            && item.value<QObject*>() == target;
+    };
+
+    switch (propValue.typeId()) {
+    case QMetaType::QVariantList: {
+        QVariantList list = propValue.toList();
+        list.removeIf(isTarget);
+        for (QVariant &item : list) {
+            item = removeReference(item, target);
+        }
+        return list;
+    }
+    case QMetaType::QVariantMap: {
+        QVariantMap map = propValue.toMap();
+        map.removeIf([&isTarget](const QVariantMap::iterator &it) { return isTarget(it.value()); });
+        for (QVariant &item : map) {
+            item = removeReference(item, target);
+        }
+        return map;
+    }
+    default:
+        return propValue;
+    }
+}
+
+/*! Converts JS values (e.g., of 'property var') to a detached copy of plain variants, other values
+ *  are returned as is
+ * ************************************************************************************************/
+QVariant QSSerializerCpp::toPlainValue(const QVariant &value)
+{
+    return value.metaType() == QMetaType::fromType<QJSValue>()
+         ? value.value<QJSValue>().toVariant()
+         : value;
+}
+
+/*! Returns the compact JSON of a serialized value (see getQSProp()). Maps are written with sorted
+ *  keys, so equal values always result in the same string.
+ * ************************************************************************************************/
+QByteArray QSSerializerCpp::toCompactJson(const QVariant &qsProp)
+{
+    // Wrap in array, as JSON documents cannot hold plain values
+    const QByteArray json = QJsonDocument(QJsonArray{ QJsonValue::fromVariant(qsProp) })
+                                .toJson(QJsonDocument::Compact);
+
+    // Strip the wrapping brackets
+    return json.mid(1, json.size() - 2);
+}
+
+/*! Returns whether two (deserialized) values are structurally equal: objects by identity, lists
+ *  and maps by their items, numbers regardless of their type, dates also against milliseconds since
+ *  epoch, and sizes/points/rects regardless of integer or floating point representation.
+ * ************************************************************************************************/
+bool QSSerializerCpp::isEqualValue(const QVariant &lhsValue, const QVariant &rhsValue)
+{
+    const QVariant lhs = toPlainValue(lhsValue);
+    const QVariant rhs = toPlainValue(rhsValue);
+
+    // Objects are equal by identity (null objects equal null values)
+    const bool isLhsObject = lhs.metaType().flags().testFlag(QMetaType::PointerToQObject);
+    const bool isRhsObject = rhs.metaType().flags().testFlag(QMetaType::PointerToQObject);
+
+    if (isLhsObject || isRhsObject) {
+        const QObject *lhsObject = isLhsObject ? lhs.value<QObject*>() : nullptr;
+        const QObject *rhsObject = isRhsObject ? rhs.value<QObject*>() : nullptr;
+
+        return lhsObject == rhsObject
+            && (isLhsObject || isNullValue(lhs))
+            && (isRhsObject || isNullValue(rhs));
+    }
+
+    if (isNullValue(lhs) || isNullValue(rhs)) {
+        return isNullValue(lhs) && isNullValue(rhs);
+    }
+
+    // Handle arrays
+    if (isListValue(lhs) && isListValue(rhs)) {
+        const QVariantList lhsList = lhs.toList();
+        const QVariantList rhsList = rhs.toList();
+
+        if (lhsList.size() != rhsList.size()) { return false; }
+
+        for (qsizetype i = 0; i < lhsList.size(); ++i) {
+            if (!isEqualValue(lhsList.at(i), rhsList.at(i))) { return false; }
+        }
+        return true;
+    }
+
+    // Handle property maps
+    if (isMapValue(lhs) && isMapValue(rhs)) {
+        const QVariantMap lhsMap = lhs.toMap();
+        const QVariantMap rhsMap = rhs.toMap();
+
+        if (lhsMap.size() != rhsMap.size()) { return false; }
+
+        for (auto it = lhsMap.cbegin(); it != lhsMap.cend(); ++it) {
+            const auto rhsIt = rhsMap.constFind(it.key());
+
+            if (rhsIt == rhsMap.cend() || !isEqualValue(it.value(), rhsIt.value())) { return false; }
+        }
+        return true;
+    }
+
+    // Handle numbers (JS only knows doubles)
+    if (isNumericValue(lhs) && isNumericValue(rhs)) {
+        return lhs.toDouble() == rhs.toDouble();
+    }
+
+    // Handle dates (also against parsed dates, i.e., milliseconds since epoch)
+    if (lhs.typeId() == QMetaType::QDateTime || rhs.typeId() == QMetaType::QDateTime) {
+        const auto toMSecs = [](const QVariant &value) {
+            return value.typeId() == QMetaType::QDateTime ? value.toDateTime().toMSecsSinceEpoch()
+                                                          : qint64(value.toDouble());
+        };
+
+        return (lhs.typeId() == QMetaType::QDateTime || isNumericValue(lhs))
+            && (rhs.typeId() == QMetaType::QDateTime || isNumericValue(rhs))
+            && toMSecs(lhs) == toMSecs(rhs);
+    }
+
+    // Handle geometry types (QML uses the floating point variants)
+    const auto isOneOf = [](const QVariant &value, QMetaType::Type type, QMetaType::Type typeF) {
+        return value.typeId() == type || value.typeId() == typeF;
+    };
+
+    if (isOneOf(lhs, QMetaType::QSize, QMetaType::QSizeF)
+            && isOneOf(rhs, QMetaType::QSize, QMetaType::QSizeF)) {
+        return lhs.toSizeF() == rhs.toSizeF();
+    }
+
+    if (isOneOf(lhs, QMetaType::QPoint, QMetaType::QPointF)
+            && isOneOf(rhs, QMetaType::QPoint, QMetaType::QPointF)) {
+        return lhs.toPointF() == rhs.toPointF();
+    }
+
+    if (isOneOf(lhs, QMetaType::QRect, QMetaType::QRectF)
+            && isOneOf(rhs, QMetaType::QRect, QMetaType::QRectF)) {
+        return lhs.toRectF() == rhs.toRectF();
+    }
+
+    // Default: compare as is (e.g., strings, booleans, vectors)
+    return lhs == rhs;
+}
+
+/*! Returns an estimate of the memory used by value (including its payload)
+ * ************************************************************************************************/
+qint64 QSSerializerCpp::estimateSize(const QVariant &value)
+{
+    qint64 size = sizeof(QVariant);
+
+    switch (value.typeId()) {
+    case QMetaType::QString:
+        size += value.toString().size() * qint64(sizeof(QChar));
+        break;
+    case QMetaType::QByteArray:
+        size += value.toByteArray().size();
+        break;
+    case QMetaType::QStringList:
+        for (const QString &item : value.toStringList()) {
+            size += sizeof(QString) + item.size() * qint64(sizeof(QChar));
+        }
+        break;
+    case QMetaType::QVariantList:
+        for (const QVariant &item : value.toList()) {
+            size += estimateSize(item);
+        }
+        break;
+    case QMetaType::QVariantMap: {
+        const QVariantMap map = value.toMap();
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            size += sizeof(QString) + it.key().size() * qint64(sizeof(QChar))
+                  + estimateSize(it.value());
+        }
+        break;
+    }
+    default:
+        // Other types are small enough to be stored inside the QVariant
+        break;
+    }
+
+    return size;
+}
+
+/*! Returns the index of the property notified by the signal with signalIndex, or -1. The lookup
+ *  table is cached per type (QML objects have a meta object per instance).
+ *
+ * \note    Thread safe, e.g., replays run on several threads (see qqstool replay --jobs)
+ * ************************************************************************************************/
+int QSSerializerCpp::propertyIndexForSignal(const QMetaObject *metaObject, int signalIndex)
+{
+    // Sanity check
+    if (metaObject == nullptr || signalIndex < 0) { return -1; }
+
+    SignalPropertyCache &cache     = signalPropertyCache();
+    const QByteArray     className (metaObject->className());
+
+    {
+        QReadLocker locker(&cache.lock);
+
+        const auto it = cache.signalProperties.constFind(className);
+        if (it != cache.signalProperties.cend()) { return it->value(signalIndex, -1); }
+    }
+
+    // Build the lookup table of this type (concurrent builds of the same type are identical)
+    QHash<int, int> signalProperties;
+    for (int i = 0; i < metaObject->propertyCount(); ++i) {
+        const int notifyIndex = metaObject->property(i).notifySignalIndex();
+
+        if (notifyIndex >= 0 && !signalProperties.contains(notifyIndex)) {
+            signalProperties.insert(notifyIndex, i);
+        }
+    }
+
+    const int propertyIndex = signalProperties.value(signalIndex, -1);
+
+    QWriteLocker locker(&cache.lock);
+    cache.signalProperties.insert(className, std::move(signalProperties));
+
+    return propertyIndex;
+}
+
+/* ************************************************************************************************
+ * Public Slots
+ * ************************************************************************************************/
+/*! Returns whether two values are structurally equal (see isEqualValue())
+ * ************************************************************************************************/
+bool QSSerializerCpp::isEqual(const QVariant &lhs, const QVariant &rhs) const
+{
+    return isEqualValue(lhs, rhs);
+}
+
+/*! Returns the value tagged with its type (see QSValueCodecs), undefined if it has no codec
+ * ************************************************************************************************/
+QVariant QSSerializerCpp::encodeValue(const QVariant &value) const
+{
+    return QSValueCodecs::encode(value);
+}
+
+/*! Returns the tagged value of the enum property propName of object (see getEnumPropNames())
+ * ************************************************************************************************/
+QVariant QSSerializerCpp::encodeEnumProp(const QObject *object, const QString &propName) const
+{
+    // Sanity check
+    if (object == nullptr) { return QVariant(); }
+
+    const QMetaProperty metaProperty = object->metaObject()->property(
+        object->metaObject()->indexOfProperty(propName.toLatin1().constData()));
+
+    return metaProperty.isEnumType()
+         ? QSValueCodecs::encodeEnum(metaProperty.enumerator(), metaProperty.read(object).toInt())
+         : metaProperty.read(object);
+}
+
+/*! Returns the value of a tagged map, undefined if the map is not tagged
+ * ************************************************************************************************/
+QVariant QSSerializerCpp::decodeValue(const QVariantMap &qsValue) const
+{
+    return QSValueCodecs::decode(qsValue);
+}
+
+/*! Returns the names of all enum properties of object (cached per type)
+ * ************************************************************************************************/
+QStringList QSSerializerCpp::getEnumPropNames(const QObject *object)
+{
+    // Sanity check
+    if (object == nullptr) { return QStringList(); }
+
+    // Cached by class name (QML objects can have a meta object of their own)
+    const QMetaObject *metaObject = object->metaObject();
+    const QByteArray   className  = metaObject->className();
+
+    auto it = m_enumPropNames.constFind(className);
+    if (it == m_enumPropNames.constEnd()) {
+        QStringList enumPropNames;
+        for (int i = 0; i < metaObject->propertyCount(); ++i) {
+            const QMetaProperty metaProperty = metaObject->property(i);
+
+            if (metaProperty.isEnumType() && !isPropertyBlackListed(metaProperty.name())) {
+                enumPropNames.append(QString::fromLatin1(metaProperty.name()));
+            }
+        }
+
+        it = m_enumPropNames.insert(className, enumPropNames);
+    }
+
+    return it.value();
+}
+
+/*! Returns whether object is serialized by a compile-time schema (see QSSchema)
+ * ************************************************************************************************/
+bool QSSerializerCpp::hasSchema(const QObject *object) const
+{
+    return object != nullptr && QSSchemaRegistry::find(object->metaObject()).isValid();
+}
+
+/*! Returns the properties of object serialized by its schema (empty if it has none)
+ * ************************************************************************************************/
+QVariantMap QSSerializerCpp::getSchemaProps(const QObject *object) const
+{
+    const QSSchemaRegistry::Entry schema = object != nullptr
+                                         ? QSSchemaRegistry::find(object->metaObject())
+                                         : QSSchemaRegistry::Entry();
+
+    return schema.isValid() ? schema.toQSProps(object) : QVariantMap();
+}
+
+/*! Applies the fields of the schema of object, and returns the properties that are left for the
+ *  generic path (e.g., references)
+ * ************************************************************************************************/
+QVariantMap QSSerializerCpp::applySchemaProps(QObject *object, const QVariantMap &qsProps) const
+{
+    const QSSchemaRegistry::Entry schema = object != nullptr
+                                         ? QSSchemaRegistry::find(object->metaObject())
+                                         : QSSchemaRegistry::Entry();
+
+    return schema.isValid() ? schema.applyQSProps(object, qsProps) : qsProps;
+}
@@ -0,0 +1,606 @@
+#include "QSUndoHistoryCpp.h"
+#include "QSObjectCpp.h"
+#include "QSObjectListCpp.h"
+#include "QSRepositoryCpp.h"
+#include "QSSerializerCpp.h"
+
+#include <QDebug>
+#include <QMetaProperty>
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+//! Guarded object reference in a stored value (see QSUndoHistoryCpp::guardValue())
+struct ObjectRef {
+    QPointer<QObject>   object;
+    QString             uuidStr;        //!< Used if object was destroyed (empty if no QSObject)
+    QMetaType           metaType;       //!< Pointer type of the original value
+};
+
+}
+
+Q_DECLARE_METATYPE(ObjectRef)
+
+/* ************************************************************************************************
+ * Public Constructors & Destructor
+ * ************************************************************************************************/
+/*! Creates a (disabled) history for repo
+ * ************************************************************************************************/
+QSUndoHistoryCpp::QSUndoHistoryCpp(QSRepositoryCpp *repo)
+  : QObject         {repo}
+  , m_repo          (repo)
+  , m_enabled       (false)
+  , m_isApplying    (false)
+  , m_byteBudget    (8 * 1024 * 1024)
+  , m_usedBytes     (0)
+  , m_capturedBytes (0)
+  , m_commands      ()
+  , m_index         (0)
+  , m_commandDepth  (0)
+  , m_openCommand   ()
+  , m_openPropertyChanges()
+  , m_values        ()
+{
+}
+
+/* ************************************************************************************************
+ * Public Getters & Setters
+ * ************************************************************************************************/
+bool QSUndoHistoryCpp::isEnabled() const
+{
+    return m_enabled;
+}
+
+qint64 QSUndoHistoryCpp::getByteBudget() const
+{
+    return m_byteBudget;
+}
+
+/*! Returns the (estimated) memory used by all recorded commands, which is limited by byteBudget
+ * ************************************************************************************************/
+qint64 QSUndoHistoryCpp::getUsedBytes() const
+{
+    return m_usedBytes;
+}
+
+/*! Returns the (estimated) memory used by the last known values of all objects (not limited by
+ *  byteBudget, see getObjectBytes() for single objects)
+ * ************************************************************************************************/
+qint64 QSUndoHistoryCpp::getCapturedBytes() const
+{
+    return m_capturedBytes;
+}
+
+bool QSUndoHistoryCpp::canUndo() const
+{
+    return m_index > 0;
+}
+
+bool QSUndoHistoryCpp::canRedo() const
+{
+    return m_index < m_commands.size();
+}
+
+QString QSUndoHistoryCpp::getUndoText() const
+{
+    return canUndo() ? m_commands.at(m_index - 1).text : QString();
+}
+
+QString QSUndoHistoryCpp::getRedoText() const
+{
+    return canRedo() ? m_commands.at(m_index).text : QString();
+}
+
+/*! Enables/disables recording. Enabling captures the current values of all objects in the repo.
+ * ************************************************************************************************/
+void QSUndoHistoryCpp::setEnabled(bool enabled)
+{
+    // Sanity check
+    if (m_enabled == enabled) { return; }
+
+    m_enabled = enabled;
+
+    clear();
+    m_values.clear();
+    m_capturedBytes = 0;
+
+    if (m_enabled) {
+        for (const QVariant &qsObjectVar : std::as_const(m_repo->m_objects)) {
+            captureObject(qsObjectVar.value<QSObjectCpp*>());
+        }
+    }
+
+    emit enabledChanged();
+    emit historyChanged();
+}
+
+void QSUndoHistoryCpp::setByteBudget(qint64 byteBudget)
+{
+    // Sanity check
+    if (m_byteBudget == byteBudget) { return; }
+
+    m_byteBudget = byteBudget;
+    emit byteBudgetChanged();
+
+    trimToBudget();
+    emit historyChanged();
+}
+
+/* ************************************************************************************************
+ * Public Functions
+ * ************************************************************************************************/
+/*! Records the addition of an object to the repository
+ * ************************************************************************************************/
+void QSUndoHistoryCpp::recordAdded(const QString &uuidStr, QSObjectCpp *qsObject)
+{
+    captureObject(qsObject);
+
+    if (!m_enabled || m_isApplying || m_repo->m_isLoading) { return; }
+
+    record({ Change::Added, uuidStr, qsObject, -1, QVariant(), QVariant() });
+}
+
+/*! Records the deletion of an object from the repository
+ * ************************************************************************************************/
+void QSUndoHistoryCpp::recordDeleted(const QString &uuidStr, QSObjectCpp *qsObject)
+{
+    releaseObject(qsObject);
+
+    if (!m_enabled || m_isApplying || m_repo->m_isLoading) { return; }
+
+    record({ Change::Deleted, uuidStr, qsObject, -1, QVariant(), QVariant() });
+}
+
+/*! Records the change of a property (or of all properties if propertyIndex is -1)
+ * ************************************************************************************************/
+void QSUndoHistoryCpp::recordChanged(QSObjectCpp *qsObject, int propertyIndex)
+{
+    // Sanity check
+    if (!m_enabled || qsObject == nullptr) { return; }
+
+    auto valuesIt = m_values.find(qsObject);
+    if (valuesIt == m_values.end()) { return; }
+
+    if (propertyIndex >= 0) {
+        recordProperty(qsObject, valuesIt.value(), propertyIndex);
+        return;
+    }
+
+    const QList<int> propertyIndices = valuesIt.value().keys();
+    for (int index : propertyIndices) {
+        recordProperty(qsObject, valuesIt.value(), index);
+    }
+}
+
+/*! Stores the current values of all observable properties of the object
+ * ************************************************************************************************/
+void QSUndoHistoryCpp::captureObject(QSObjectCpp *qsObject)
+{
+    // Sanity check
+    if (!m_enabled || qsObject == nullptr) { return; }
+
+    QHash<int, QVariant> &values = m_values[qsObject];
+    m_capturedBytes -= estimateBytes(values);
+    values.clear();
+
+    const QMetaObject *metaObject = qsObject->metaObject();
+    for (int i = 0; i < metaObject->propertyCount(); ++i) {
+        const QMetaProperty metaProperty = metaObject->property(i);
+
+        if (!metaProperty.hasNotifySignal()
+                || QSSerializerCpp::isPropertyBlackListed(metaProperty.name())) {
+            continue;
+        }
+
+        // Object lists are usually read-only properties, their elements are tracked
+        if (!metaProperty.isWritable() && toObjectList(metaProperty.read(qsObject)) == nullptr) {
+            continue;
+        }
+
+        values.insert(i, guardValue(readValue(qsObject, i)));
+    }
+
+    m_capturedBytes += estimateBytes(values);
+}
+
+/*! Forgets the stored values of the object
+ * ************************************************************************************************/
+void QSUndoHistoryCpp::releaseObject(QSObjectCpp *qsObject)
+{
+    const auto valuesIt = m_values.find(qsObject);
+
+    // Sanity check
+    if (valuesIt == m_values.end()) { return; }
+
+    m_capturedBytes -= estimateBytes(valuesIt.value());
+    m_values.erase(valuesIt);
+}
+
+/*! Returns the estimated size of the stored values of the object (0 if disabled)
+ * ************************************************************************************************/
+qint64 QSUndoHistoryCpp::getObjectBytes(const QSObjectCpp *qsObject) const
+{
+    const auto valuesIt = m_values.constFind(qsObject);
+
+    return valuesIt != m_values.constEnd() ? estimateBytes(valuesIt.value()) : 0;
+}
+
+/*! Returns whether a recorded command refers to the object, e.g., to add it again on undo or as a
+ *  property value. Such objects must not be reused (see QSObjectPoolCpp::recycle()).
+ * ************************************************************************************************/
+bool QSUndoHistoryCpp::holdsObject(const QSObjectCpp *qsObject) const
+{
+    // Sanity check
+    if (qsObject == nullptr) { return false; }
+
+    const QString uuidStr = qsObject->getUuidStr();
+
+    const auto holds = [&](const Command &command) {
+        return std::any_of(command.changes.cbegin(), command.changes.cend(),
+                           [&](const Change &change) {
+                               return change.qsObject.data() == qsObject || change.uuidStr == uuidStr
+                                   || refersTo(change.before, qsObject)
+                                   || refersTo(change.after,  qsObject);
+                           });
+    };
+
+    return holds(m_openCommand) || std::any_of(m_commands.cbegin(), m_commands.cend(), holds);
+}
+
+/* ************************************************************************************************
+ * Public Slots
+ * ************************************************************************************************/
+/*! Starts grouping changes into a single command (can be nested)
+ * ************************************************************************************************/
+void QSUndoHistoryCpp::beginCommand(const QString &text)
+{
+    if (m_commandDepth++ == 0) {
+        m_openCommand.text = text;
+    }
+}
+
+/*! Finishes the outermost command and pushes it onto the history
+ * ************************************************************************************************/
+void QSUndoHistoryCpp::endCommand()
+{
+    // Sanity check
+    if (m_commandDepth == 0) {
+        qWarning() << "[QSUndoHistory] endCommand() called without beginCommand()";
+        return;
+    }
+
+    if (--m_commandDepth > 0) { return; }
+
+    m_openPropertyChanges.clear();
+    pushCommand(std::exchange(m_openCommand, Command()));
+}
+
+/*! Reverts the last applied command
+ * ************************************************************************************************/
+bool QSUndoHistoryCpp::undo()
+{
+    // Sanity check
+    if (!canUndo() || m_commandDepth > 0) { return false; }
+
+    applyCommand(m_commands.at(--m_index), true);
+    emit historyChanged();
+
+    return true;
+}
+
+/*! Re-applies the last reverted command
+ * ************************************************************************************************/
+bool QSUndoHistoryCpp::redo()
+{
+    // Sanity check
+    if (!canRedo() || m_commandDepth > 0) { return false; }
+
+    applyCommand(m_commands.at(m_index++), false);
+    emit historyChanged();
+
+    return true;
+}
+
+/*! Removes all commands (keeps the stored property values)
+ * ************************************************************************************************/
+void QSUndoHistoryCpp::clear()
+{
+    m_commands.clear();
+    m_index         = 0;
+    m_usedBytes     = 0;
+    m_commandDepth  = 0;
+    m_openCommand   = Command();
+    m_openPropertyChanges.clear();
+
+    emit historyChanged();
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+/*! Adds a change to the open command, or pushes it as a command of its own
+ * ************************************************************************************************/
+void QSUndoHistoryCpp::record(Change &&change)
+{
+    if (m_commandDepth == 0) {
+        Command command;
+        command.changes.append(std::move(change));
+        pushCommand(std::move(command));
+        return;
+    }
+
+    // Merge subsequent changes of the same property (keep the first 'before')
+    if (change.kind == Change::Property) {
+        const auto key = qMakePair(static_cast<const QObject*>(change.qsObject.data()),
+                                   change.propertyIndex);
+
+        auto it = m_openPropertyChanges.constFind(key);
+        if (it != m_openPropertyChanges.constEnd()) {
+            m_openCommand.changes[it.value()].after = change.after;
+            return;
+        }
+
+        m_openPropertyChanges.insert(key, m_openCommand.changes.size());
+    }
+
+    m_openCommand.changes.append(std::move(change));
+}
+
+/*! Records a property change if the value differs from the stored value
+ * ************************************************************************************************/
+void QSUndoHistoryCpp::recordProperty(QSObjectCpp *qsObject, QHash<int, QVariant> &values,
+                                      int propertyIndex)
+{
+    // Sanity check: skip untracked properties
+    auto valueIt = values.find(propertyIndex);
+    if (valueIt == values.end()) { return; }
+
+    const QVariant value = readValue(qsObject, propertyIndex);
+
+    if (QSSerializerCpp::isEqualValue(value, resolveValue(valueIt.value()))) { return; }
+
+    QVariant after = guardValue(value);
+    m_capturedBytes += QSSerializerCpp::estimateSize(after)
+                     - QSSerializerCpp::estimateSize(valueIt.value());
+
+    QVariant before = std::exchange(valueIt.value(), after);
+
+    if (m_isApplying || m_repo->m_isLoading) { return; }
+
+    record({ Change::Property, qsObject->getUuidStr(), qsObject, propertyIndex,
+             std::move(before), std::move(after) });
+}
+
+/*! Pushes command (dropping all redoable commands) and enforces the byte budget
+ * ************************************************************************************************/
+void QSUndoHistoryCpp::pushCommand(Command &&command)
+{
+    // Sanity check
+    if (command.changes.isEmpty()) { return; }
+
+    for (const Change &change : std::as_const(command.changes)) {
+        command.bytes += estimateBytes(change);
+    }
+
+    // Drop redoable commands
+    while (m_commands.size() > m_index) {
+        m_usedBytes -= m_commands.takeLast().bytes;
+    }
+
+    m_usedBytes += command.bytes;
+    m_commands.append(std::move(command));
+    ++m_index;
+
+    trimToBudget();
+    emit historyChanged();
+}
+
+/*! Applies the changes of a command in reverse (undo) or recorded (redo) order
+ * ************************************************************************************************/
+void QSUndoHistoryCpp::applyCommand(const Command &command, bool isUndo)
+{
+    m_isApplying = true;
+    m_repo->beginBatch();
+
+    const qsizetype count = command.changes.size();
+    for (qsizetype i = 0; i < count; ++i) {
+        const Change &change = command.changes.at(isUndo ? count - 1 - i : i);
+        QSObjectCpp  *qsObject = change.qsObject.data();
+
+        if (qsObject == nullptr) {
+            qWarning() << "[QSUndoHistory] Skipping change of destroyed object" << change.uuidStr;
+            continue;
+        }
+
+        if (change.kind == Change::Property) {
+            writeValue(qsObject, change.propertyIndex,
+                       resolveValue(isUndo ? change.before : change.after));
+            continue;
+        }
+
+        // Additions are reverted by deletions and vice versa
+        const bool isAdd = (change.kind == Change::Added) != isUndo;
+        const bool isRegistered = m_repo->m_objects.contains(change.uuidStr);
+
+        if (isAdd && !isRegistered) {
+            if (qsObject->getRepo() == nullptr) { qsObject->setRepo(m_repo); }
+
+            if (!m_repo->m_objects.contains(change.uuidStr)) {
+                m_repo->addObject(change.uuidStr, qsObject);
+            }
+        } else if (!isAdd && isRegistered) {
+            if (qsObject->getRepo() == m_repo) { qsObject->setRepo(nullptr); }
+
+            if (m_repo->m_objects.contains(change.uuidStr)) {
+                m_repo->delObject(change.uuidStr);
+            }
+        }
+    }
+
+    m_repo->commitBatch();
+    m_isApplying = false;
+}
+
+/*! Returns the (plain) value of a property, or the elements if it holds an object list
+ * ************************************************************************************************/
+QVariant QSUndoHistoryCpp::readValue(QSObjectCpp *qsObject, int propertyIndex) const
+{
+    const QVariant value = QSSerializerCpp::toPlainValue(
+                               qsObject->metaObject()->property(propertyIndex).read(qsObject));
+
+    const QSObjectListCpp *qsList = toObjectList(value);
+
+    return qsList != nullptr ? qsList->getElements() : value;
+}
+
+/*! Writes a value read by readValue(): object lists are updated in place
+ * ************************************************************************************************/
+void QSUndoHistoryCpp::writeValue(QSObjectCpp *qsObject, int propertyIndex,
+                                  const QVariant &value) const
+{
+    const QMetaProperty metaProperty = qsObject->metaObject()->property(propertyIndex);
+
+    if (QSObjectListCpp *qsList = toObjectList(metaProperty.read(qsObject))) {
+        qsList->setElements(value.toList());
+        return;
+    }
+
+    metaProperty.write(qsObject, value);
+}
+
+/*! Returns value with guarded object references resolved: destroyed objects are looked up by UUID
+ *  (e.g., if they were paged in again), otherwise they become null
+ * ************************************************************************************************/
+QVariant QSUndoHistoryCpp::resolveValue(const QVariant &value) const
+{
+    if (value.metaType() == QMetaType::fromType<ObjectRef>()) {
+        const ObjectRef objectRef = value.value<ObjectRef>();
+
+        QObject *object = objectRef.object.data();
+        if (object == nullptr && !objectRef.uuidStr.isEmpty()) {
+            object = m_repo->getObject(objectRef.uuidStr);
+        }
+
+        return QVariant(objectRef.metaType, &object);
+    }
+
+    if (value.typeId() == QMetaType::QVariantList) {
+        QVariantList list = value.toList();
+        for (QVariant &item : list) { item = resolveValue(item); }
+        return list;
+    }
+
+    if (value.typeId() == QMetaType::QVariantMap) {
+        QVariantMap map = value.toMap();
+        for (QVariant &item : map) { item = resolveValue(item); }
+        return map;
+    }
+
+    return value;
+}
+
+/*! Returns value with all (non-null) object references replaced by guarded ones (see ObjectRef), so
+ *  stored values never hold dangling pointers
+ * ************************************************************************************************/
+QVariant QSUndoHistoryCpp::guardValue(const QVariant &value)
+{
+    if (value.metaType().flags().testFlag(QMetaType::PointerToQObject)) {
+        QObject *object = value.value<QObject*>();
+
+        // Sanity check: nothing to guard
+        if (object == nullptr) { return value; }
+
+        const QSObjectCpp *qsObject = qobject_cast<QSObjectCpp*>(object);
+
+        return QVariant::fromValue(ObjectRef { object,
+                                               qsObject != nullptr ? qsObject->getUuidStr() : QString(),
+                                               value.metaType() });
+    }
+
+    if (value.typeId() == QMetaType::QVariantList) {
+        QVariantList list = value.toList();
+        for (QVariant &item : list) { item = guardValue(item); }
+        return list;
+    }
+
+    if (value.typeId() == QMetaType::QVariantMap) {
+        QVariantMap map = value.toMap();
+        for (QVariant &item : map) { item = guardValue(item); }
+        return map;
+    }
+
+    return value;
+}
+
+/*! Returns whether a stored value (see guardValue()) refers to the object
+ * ************************************************************************************************/
+bool QSUndoHistoryCpp::refersTo(const QVariant &value, const QSObjectCpp *qsObject)
+{
+    if (value.metaType() == QMetaType::fromType<ObjectRef>()) {
+        const ObjectRef objectRef = value.value<ObjectRef>();
+
+        return objectRef.object.data() == qsObject || objectRef.uuidStr == qsObject->getUuidStr();
+    }
+
+    if (value.typeId() == QMetaType::QVariantList) {
+        const QVariantList list = value.toList();
+        return std::any_of(list.cbegin(), list.cend(),
+                           [&](const QVariant &item) { return refersTo(item, qsObject); });
+    }
+
+    if (value.typeId() == QMetaType::QVariantMap) {
+        const QVariantMap map = value.toMap();
+        return std::any_of(map.cbegin(), map.cend(),
+                           [&](const QVariant &item) { return refersTo(item, qsObject); });
+    }
+
+    return false;
+}
+
+/*! Returns the object list held by value, if any
+ * ************************************************************************************************/
+QSObjectListCpp *QSUndoHistoryCpp::toObjectList(const QVariant &value)
+{
+    return value.metaType().flags().testFlag(QMetaType::PointerToQObject)
+         ? qobject_cast<QSObjectListCpp*>(value.value<QObject*>())
+         : nullptr;
+}
+
+/*! Drops the oldest commands until they fit the byte budget (keeps at least one)
+ * ************************************************************************************************/
+void QSUndoHistoryCpp::trimToBudget()
+{
+    while (m_usedBytes > m_byteBudget && m_commands.size() > 1) {
+        // Drop oldest undoable command, or the newest redoable one if nothing is applied
+        if (m_index > 0) {
+            m_usedBytes -= m_commands.takeFirst().bytes;
+            --m_index;
+        } else {
+            m_usedBytes -= m_commands.takeLast().bytes;
+        }
+    }
+}
+
+/*! Returns the estimated memory used by a change
+ * ************************************************************************************************/
+qint64 QSUndoHistoryCpp::estimateBytes(const Change &change)
+{
+    return sizeof(Change)
+         + change.uuidStr.size() * qint64(sizeof(QChar))
+         + QSSerializerCpp::estimateSize(change.before)
+         + QSSerializerCpp::estimateSize(change.after);
+}
+
+/*! Returns the estimated memory used by the stored values of an object
+ * ************************************************************************************************/
+qint64 QSUndoHistoryCpp::estimateBytes(const QHash<int, QVariant> &values)
+{
+    qint64 bytes = 0;
+    for (const QVariant &value : values) {
+        bytes += sizeof(int) + QSSerializerCpp::estimateSize(value);
+    }
+
+    return bytes;
+}
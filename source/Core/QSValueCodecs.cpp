@@ -0,0 +1,261 @@
+#include "QSValueCodecs.h"
+
+#include <QColor>
+#include <QDateTime>
+#include <QHash>
+#include <QPointF>
+#include <QReadWriteLock>
+#include <QRectF>
+#include <QSizeF>
+#include <QUrl>
+#include <QVector2D>
+#include <QVector3D>
+
+const QString QSValueCodecs::typeKey = QStringLiteral("qsValueType");
+
+namespace {
+
+const QString enumTag = QStringLiteral("enum");
+
+struct Codec
+{
+    QString                 tag;
+    QSValueCodecs::Encoder  encoder;
+    QSValueCodecs::Decoder  decoder;
+};
+
+/*! Codecs by QMetaType id (for encoding) and by tag (for decoding)
+ * ************************************************************************************************/
+struct Registry
+{
+    Registry();
+
+    QReadWriteLock          lock;
+    QHash<int, Codec>       codecsByType;
+    QHash<QString, Codec>   codecsByTag;
+};
+
+//! Adds codec (the caller takes care of locking)
+void insertCodec(Registry &codecs, QMetaType metaType, const QString &tag,
+                 const QSValueCodecs::Encoder &encoder, const QSValueCodecs::Decoder &decoder)
+{
+    const Codec codec { tag, encoder, decoder };
+    codecs.codecsByType.insert(metaType.id(), codec);
+
+    if (!codecs.codecsByTag.contains(tag)) {
+        codecs.codecsByTag.insert(tag, codec);
+    }
+}
+
+//! Returns whether all keys are present in fields
+bool hasFields(const QVariantMap &fields, std::initializer_list<const char*> keys)
+{
+    for (const char *key : keys) {
+        if (!fields.contains(QLatin1String(key))) { return false; }
+    }
+
+    return true;
+}
+
+double field(const QVariantMap &fields, const char *key)
+{
+    return fields.value(QLatin1String(key)).toDouble();
+}
+
+void registerBuiltinCodecs(Registry &codecs)
+{
+    // Vectors
+    insertCodec(
+        codecs, QMetaType::fromType<QVector2D>(), QStringLiteral("vector2d"),
+        [](const QVariant &value) -> QVariantMap {
+            const QVector2D vector = value.value<QVector2D>();
+            return { { "x", vector.x() }, { "y", vector.y() } };
+        },
+        [](const QVariantMap &fields) -> QVariant {
+            if (!hasFields(fields, { "x", "y" })) { return QVariant(); }
+            return QVector2D(field(fields, "x"), field(fields, "y"));
+        });
+
+    insertCodec(
+        codecs, QMetaType::fromType<QVector3D>(), QStringLiteral("vector3d"),
+        [](const QVariant &value) -> QVariantMap {
+            const QVector3D vector = value.value<QVector3D>();
+            return { { "x", vector.x() }, { "y", vector.y() }, { "z", vector.z() } };
+        },
+        [](const QVariantMap &fields) -> QVariant {
+            if (!hasFields(fields, { "x", "y", "z" })) { return QVariant(); }
+            return QVector3D(field(fields, "x"), field(fields, "y"), field(fields, "z"));
+        });
+
+    // Geometry (integer types share the tag and decode as floating point types)
+    const auto pointEncoder = [](const QVariant &value) -> QVariantMap {
+        const QPointF point = value.toPointF();
+        return { { "x", point.x() }, { "y", point.y() } };
+    };
+    const auto pointDecoder = [](const QVariantMap &fields) -> QVariant {
+        if (!hasFields(fields, { "x", "y" })) { return QVariant(); }
+        return QPointF(field(fields, "x"), field(fields, "y"));
+    };
+    insertCodec(codecs, QMetaType::fromType<QPointF>(), QStringLiteral("point"),
+                pointEncoder, pointDecoder);
+    insertCodec(codecs, QMetaType::fromType<QPoint>(),  QStringLiteral("point"),
+                pointEncoder, pointDecoder);
+
+    const auto sizeEncoder = [](const QVariant &value) -> QVariantMap {
+        const QSizeF size = value.toSizeF();
+        return { { "width", size.width() }, { "height", size.height() } };
+    };
+    const auto sizeDecoder = [](const QVariantMap &fields) -> QVariant {
+        if (!hasFields(fields, { "width", "height" })) { return QVariant(); }
+        return QSizeF(field(fields, "width"), field(fields, "height"));
+    };
+    insertCodec(codecs, QMetaType::fromType<QSizeF>(), QStringLiteral("size"),
+                sizeEncoder, sizeDecoder);
+    insertCodec(codecs, QMetaType::fromType<QSize>(),  QStringLiteral("size"),
+                sizeEncoder, sizeDecoder);
+
+    const auto rectEncoder = [](const QVariant &value) -> QVariantMap {
+        const QRectF rect = value.toRectF();
+        return { { "x", rect.x() }, { "y", rect.y() },
+                 { "width", rect.width() }, { "height", rect.height() } };
+    };
+    const auto rectDecoder = [](const QVariantMap &fields) -> QVariant {
+        if (!hasFields(fields, { "x", "y", "width", "height" })) { return QVariant(); }
+        return QRectF(field(fields, "x"), field(fields, "y"),
+                      field(fields, "width"), field(fields, "height"));
+    };
+    insertCodec(codecs, QMetaType::fromType<QRectF>(), QStringLiteral("rect"),
+                rectEncoder, rectDecoder);
+    insertCodec(codecs, QMetaType::fromType<QRect>(),  QStringLiteral("rect"),
+                rectEncoder, rectDecoder);
+
+    // Values stored as string
+    insertCodec(
+        codecs, QMetaType::fromType<QColor>(), QStringLiteral("color"),
+        [](const QVariant &value) -> QVariantMap {
+            return { { "value", value.value<QColor>().name(QColor::HexArgb) } };
+        },
+        [](const QVariantMap &fields) -> QVariant {
+            const QColor color(fields.value(QStringLiteral("value")).toString());
+            return color.isValid() ? QVariant(color) : QVariant();
+        });
+
+    insertCodec(
+        codecs, QMetaType::fromType<QDateTime>(), QStringLiteral("date"),
+        [](const QVariant &value) -> QVariantMap {
+            return { { "value", value.toDateTime().toString(Qt::ISODateWithMs) } };
+        },
+        [](const QVariantMap &fields) -> QVariant {
+            return QDateTime::fromString(fields.value(QStringLiteral("value")).toString(),
+                                         Qt::ISODateWithMs);
+        });
+
+    insertCodec(
+        codecs, QMetaType::fromType<QUrl>(), QStringLiteral("url"),
+        [](const QVariant &value) -> QVariantMap {
+            return { { "value", value.toUrl().toString() } };
+        },
+        [](const QVariantMap &fields) -> QVariant {
+            return QUrl(fields.value(QStringLiteral("value")).toString());
+        });
+}
+
+Registry::Registry()
+{
+    registerBuiltinCodecs(*this);
+}
+
+Registry &registry()
+{
+    static Registry instance;
+
+    return instance;
+}
+
+} // namespace
+
+/* ************************************************************************************************
+ * Public Static Functions
+ * ************************************************************************************************/
+/*! Registers (or replaces) the codec of metaType. Types can share a tag, values of that tag are
+ *  decoded by the codec registered first.
+ * ************************************************************************************************/
+void QSValueCodecs::registerCodec(QMetaType metaType, const QString &tag,
+                                  const Encoder &encoder, const Decoder &decoder)
+{
+    Registry &codecs = registry();
+    QWriteLocker locker(&codecs.lock);
+
+    insertCodec(codecs, metaType, tag, encoder, decoder);
+}
+
+bool QSValueCodecs::hasCodec(QMetaType metaType)
+{
+    Registry &codecs = registry();
+    QReadLocker locker(&codecs.lock);
+
+    return codecs.codecsByType.contains(metaType.id());
+}
+
+/*! Returns the tagged map of value, or an invalid variant if there is no codec for its type
+ * ************************************************************************************************/
+QVariant QSValueCodecs::encode(const QVariant &value)
+{
+    Registry &codecs = registry();
+    QReadLocker locker(&codecs.lock);
+
+    const auto it = codecs.codecsByType.constFind(value.metaType().id());
+
+    // Sanity check
+    if (it == codecs.codecsByType.constEnd()) { return QVariant(); }
+
+    QVariantMap qsValue = it->encoder(value);
+    qsValue.insert(typeKey, it->tag);
+
+    return qsValue;
+}
+
+/*! Returns the tagged map of an enum (or flags) value, the key is stored for readability
+ * ************************************************************************************************/
+QVariant QSValueCodecs::encodeEnum(const QMetaEnum &metaEnum, int value)
+{
+    return QVariantMap {
+        { typeKey,                  enumTag },
+        { QStringLiteral("enum"),   QStringLiteral("%1::%2").arg(QLatin1String(metaEnum.scope()),
+                                                                 QLatin1String(metaEnum.name())) },
+        { QStringLiteral("key"),    metaEnum.isFlag()
+                                    ? QString::fromLatin1(metaEnum.valueToKeys(value))
+                                    : QString::fromLatin1(metaEnum.valueToKey(value)) },
+        { QStringLiteral("value"),  value }
+    };
+}
+
+/*! Returns the value of a tagged map, or an invalid variant if the map is not (validly) tagged
+ * ************************************************************************************************/
+QVariant QSValueCodecs::decode(const QVariantMap &qsValue)
+{
+    const QString tag = qsValue.value(typeKey).toString();
+
+    // Sanity check
+    if (tag.isEmpty()) { return QVariant(); }
+
+    if (tag == enumTag) {
+        return qsValue.contains(QStringLiteral("value"))
+             ? QVariant(qsValue.value(QStringLiteral("value")).toInt())
+             : QVariant();
+    }
+
+    Registry &codecs = registry();
+    QReadLocker locker(&codecs.lock);
+
+    const auto it = codecs.codecsByTag.constFind(tag);
+
+    return it != codecs.codecsByTag.constEnd() ? it->decoder(qsValue) : QVariant();
+}
+
+/*! Returns whether the map is a tagged value
+ * ************************************************************************************************/
+bool QSValueCodecs::isEncoded(const QVariantMap &qsValue)
+{
+    return qsValue.contains(typeKey);
+}
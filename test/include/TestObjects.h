@@ -0,0 +1,69 @@
+#ifndef TESTOBJECTS_H
+#define TESTOBJECTS_H
+
+#include "QtQuickStream/Core/QSObjectCpp.h"
+#include "QtQuickStream/Core/QSRepositoryCpp.h"
+
+#include <QCoreApplication>
+#include <QEvent>
+
+/*! ***********************************************************************************************
+ * Types and helpers shared by the unit tests
+ * ************************************************************************************************/
+
+//! Exposes the protected (QML) slots of the repository
+class TestRepository : public QSRepositoryCpp
+{
+public:
+    using QSRepositoryCpp::addObject;
+    using QSRepositoryCpp::clearObjects;
+    using QSRepositoryCpp::delObject;
+    using QSRepositoryCpp::delObjects;
+};
+
+//! Object with a plain value and a reference to another object
+class TestObject : public QSObjectCpp
+{
+    Q_OBJECT
+    Q_PROPERTY(int          value   MEMBER m_value  NOTIFY valueChanged)
+    Q_PROPERTY(QString      label   MEMBER m_label  NOTIFY labelChanged)
+    Q_PROPERTY(QSObjectCpp *target  MEMBER m_target NOTIFY targetChanged)
+
+public:
+    explicit TestObject(QObject *parent = nullptr) : QSObjectCpp(parent) {}
+
+signals:
+    void valueChanged();
+    void labelChanged();
+    void targetChanged();
+
+private:
+    int          m_value  = 0;
+    QString      m_label;
+    QSObjectCpp *m_target = nullptr;
+};
+
+/*! Creates an object owned by and registered with repo. The repo is set after construction, so it
+ *  observes the properties of the final type.
+ * ************************************************************************************************/
+template <typename T = TestObject>
+T *createObject(QSRepositoryCpp &repo, int value = 0)
+{
+    T *qsObject = new T();
+
+    qsObject->setProperty("value", value);
+    qsObject->setParent(&repo);
+    qsObject->setProperty("_qsRepo", QVariant::fromValue(&repo));
+
+    return qsObject;
+}
+
+/*! Runs deferred deletions and queued calls (e.g., the relaying of forwarded repos)
+ * ************************************************************************************************/
+inline void processEvents()
+{
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    QCoreApplication::processEvents();
+}
+
+#endif // TESTOBJECTS_H
@@ -0,0 +1,142 @@
+#include <QtTest>
+
+#include "QSObjectCpp.h"
+#include "QSRepositoryCpp.h"
+
+/*! ***********************************************************************************************
+ * Benchmarks of bulk operations of QSRepositoryCpp. Each benchmark runs for a range of repo sizes,
+ * the time per object should stay (roughly) constant if the operation scales linearly.
+ * ************************************************************************************************/
+
+//! Exposes the protected (QML) slots of the repository
+class BenchRepository : public QSRepositoryCpp
+{
+public:
+    using QSRepositoryCpp::clearObjects;
+    using QSRepositoryCpp::delObject;
+    using QSRepositoryCpp::delObjects;
+};
+
+class BenchRepositoryCpp : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void clearObjects_data();
+    void clearObjects();
+
+    void delObjects_data();
+    void delObjects();
+
+    void delObject_data();
+    void delObject();
+
+private:
+    static void addSizes();
+    static void populate(BenchRepository &repo, int count);
+};
+
+/* ************************************************************************************************
+ * Private Slots
+ * ************************************************************************************************/
+void BenchRepositoryCpp::clearObjects_data()
+{
+    addSizes();
+}
+
+/*! Clears all objects at once (see QSRepositoryCpp::clearObjects())
+ * ************************************************************************************************/
+void BenchRepositoryCpp::clearObjects()
+{
+    QFETCH(int, count);
+
+    BenchRepository repo;
+    populate(repo, count);
+
+    QBENCHMARK_ONCE {
+        repo.clearObjects();
+    }
+
+    QVERIFY(repo.getAddedObjects().isEmpty());
+}
+
+void BenchRepositoryCpp::delObjects_data()
+{
+    addSizes();
+}
+
+/*! Deletes half of the objects (every other one) in a single call
+ * ************************************************************************************************/
+void BenchRepositoryCpp::delObjects()
+{
+    QFETCH(int, count);
+
+    BenchRepository repo;
+    populate(repo, count);
+
+    QStringList uuidStrs;
+    const QVariantList addedObjects = repo.getAddedObjects();
+    for (qsizetype i = 0; i < addedObjects.size(); i += 2) {
+        uuidStrs.append(addedObjects.at(i).value<QSObjectCpp*>()->getUuidStr());
+    }
+
+    QBENCHMARK_ONCE {
+        repo.delObjects(uuidStrs);
+    }
+
+    QCOMPARE(repo.getAddedObjects().size(), count - uuidStrs.size());
+}
+
+void BenchRepositoryCpp::delObject_data()
+{
+    addSizes();
+}
+
+/*! Deletes all objects one by one, as reference for clearObjects()
+ * ************************************************************************************************/
+void BenchRepositoryCpp::delObject()
+{
+    QFETCH(int, count);
+
+    BenchRepository repo;
+    populate(repo, count);
+
+    QStringList uuidStrs;
+    const QVariantList addedObjects = repo.getAddedObjects();
+    for (const QVariant &qsObjectVar : addedObjects) {
+        uuidStrs.append(qsObjectVar.value<QSObjectCpp*>()->getUuidStr());
+    }
+
+    QBENCHMARK_ONCE {
+        for (const QString &uuidStr : std::as_const(uuidStrs)) {
+            repo.delObject(uuidStr);
+        }
+    }
+
+    QVERIFY(repo.getAddedObjects().isEmpty());
+}
+
+/* ************************************************************************************************
+ * Private Functions
+ * ************************************************************************************************/
+void BenchRepositoryCpp::addSizes()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("1k")   << 1000;
+    QTest::newRow("10k")  << 10000;
+    QTest::newRow("100k") << 100000;
+}
+
+/*! Adds count objects to repo (registered through their parent)
+ * ************************************************************************************************/
+void BenchRepositoryCpp::populate(BenchRepository &repo, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        new QSObjectCpp(&repo);
+    }
+}
+
+QTEST_GUILESS_MAIN(BenchRepositoryCpp)
+
+#include "bench_repository.moc"
@@ -0,0 +1,148 @@
+#include <catch2/catch.hpp>
+
+#include "TestObjects.h"
+
+#include <QSignalSpy>
+
+/*! ***********************************************************************************************
+ * Tests of batches (QSRepositoryCpp::beginBatch(), commitBatch(), rollbackBatch()) and of relaying
+ * changes of forwarded repos
+ * ************************************************************************************************/
+
+TEST_CASE("Committing a batch emits bulk signals only", "[batch]")
+{
+    TestRepository repo;
+    TestObject *existing = createObject(repo);
+
+    QSignalSpy addedSpy        (&repo, &QSRepositoryCpp::objectAdded);
+    QSignalSpy deletedSpy      (&repo, &QSRepositoryCpp::objectDeleted);
+    QSignalSpy bulkAddedSpy    (&repo, &QSRepositoryCpp::objectsAdded);
+    QSignalSpy bulkDeletedSpy  (&repo, &QSRepositoryCpp::objectsDeleted);
+    QSignalSpy objectsChangedSpy(&repo, &QSRepositoryCpp::objectsChanged);
+
+    SECTION("Several objects") {
+        repo.beginBatch();
+        for (int i = 0; i < 3; ++i) { createObject(repo, i); }
+        repo.delObject(existing->getUuidStr());
+
+        CHECK(bulkAddedSpy.isEmpty());
+        CHECK(objectsChangedSpy.isEmpty());
+
+        repo.commitBatch();
+
+        CHECK(addedSpy.isEmpty());
+        REQUIRE(bulkAddedSpy.size() == 1);
+        CHECK(bulkAddedSpy.first().first().toList().size() == 3);
+
+        // A single deletion is signalled per object
+        CHECK(bulkDeletedSpy.isEmpty());
+        REQUIRE(deletedSpy.size() == 1);
+        CHECK(deletedSpy.first().first().toString() == existing->getUuidStr());
+
+        CHECK(objectsChangedSpy.size() == 1);
+    }
+
+    SECTION("Nested batches emit on the outermost commit") {
+        repo.beginBatch();
+        repo.beginBatch();
+        createObject(repo);
+        createObject(repo);
+        repo.commitBatch();
+
+        CHECK(repo.isBatching());
+        CHECK(bulkAddedSpy.isEmpty());
+
+        repo.commitBatch();
+
+        CHECK_FALSE(repo.isBatching());
+        CHECK(bulkAddedSpy.size() == 1);
+        CHECK(addedSpy.isEmpty());
+    }
+
+    SECTION("Adding and deleting an object cancels out") {
+        repo.beginBatch();
+        TestObject *temporary = createObject(repo);
+        repo.delObject(temporary->getUuidStr());
+        repo.commitBatch();
+
+        CHECK(addedSpy.isEmpty());
+        CHECK(deletedSpy.isEmpty());
+        CHECK(bulkAddedSpy.isEmpty());
+        CHECK(bulkDeletedSpy.isEmpty());
+    }
+}
+
+TEST_CASE("Rolling back a batch restores the repo", "[batch]")
+{
+    TestRepository repo;
+    TestObject *existing = createObject(repo);
+
+    const QVariantList addedObjects = repo.getAddedObjects();
+
+    QSignalSpy addedSpy      (&repo, &QSRepositoryCpp::objectAdded);
+    QSignalSpy deletedSpy    (&repo, &QSRepositoryCpp::objectDeleted);
+    QSignalSpy bulkAddedSpy  (&repo, &QSRepositoryCpp::objectsAdded);
+    QSignalSpy bulkDeletedSpy(&repo, &QSRepositoryCpp::objectsDeleted);
+
+    repo.beginBatch();
+    TestObject *added = createObject(repo);
+    repo.delObject(existing->getUuidStr());
+    repo.rollbackBatch();
+
+    CHECK_FALSE(repo.isBatching());
+    CHECK(repo.getObject(existing->getUuidStr()) == existing);
+    CHECK(repo.getObject(added->getUuidStr()) == nullptr);
+    CHECK(repo.getAddedObjects() == addedObjects);
+
+    // Observers never saw the batch
+    CHECK(addedSpy.isEmpty());
+    CHECK(deletedSpy.isEmpty());
+    CHECK(bulkAddedSpy.isEmpty());
+    CHECK(bulkDeletedSpy.isEmpty());
+}
+
+TEST_CASE("Forwarded repos relay batches in bulk", "[batch][forwarding]")
+{
+    TestRepository repo;
+    TestRepository forwardedRepo;
+
+    REQUIRE(repo.forwardRepo(&forwardedRepo));
+
+    QSignalSpy addedSpy      (&repo, &QSRepositoryCpp::objectAdded);
+    QSignalSpy bulkAddedSpy  (&repo, &QSRepositoryCpp::objectsAdded);
+    QSignalSpy deletedSpy    (&repo, &QSRepositoryCpp::objectDeleted);
+    QSignalSpy bulkDeletedSpy(&repo, &QSRepositoryCpp::objectsDeleted);
+
+    forwardedRepo.beginBatch();
+    TestObject *first = createObject(forwardedRepo);
+    createObject(forwardedRepo);
+    createObject(forwardedRepo);
+    forwardedRepo.commitBatch();
+
+    // Relayed once per event loop iteration
+    CHECK(bulkAddedSpy.isEmpty());
+    processEvents();
+
+    CHECK(addedSpy.isEmpty());
+    REQUIRE(bulkAddedSpy.size() == 1);
+    CHECK(bulkAddedSpy.first().first().toList().size() == 3);
+    CHECK(repo.getObject(first->getUuidStr()) == first);
+
+    SECTION("Single changes are relayed per object") {
+        forwardedRepo.delObject(first->getUuidStr());
+        processEvents();
+
+        CHECK(deletedSpy.size() == 1);
+        CHECK(bulkDeletedSpy.isEmpty());
+    }
+
+    SECTION("Objects added and deleted before relaying are not relayed") {
+        TestObject *temporary = createObject(forwardedRepo);
+        forwardedRepo.delObject(temporary->getUuidStr());
+        processEvents();
+
+        CHECK(addedSpy.isEmpty());
+        CHECK(deletedSpy.isEmpty());
+        CHECK(bulkAddedSpy.size() == 1);
+    }
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch.hpp>
+
+#include "TestObjects.h"
+#include "QtQuickStream/Core/HashStringCPP.h"
+
+/*! ***********************************************************************************************
+ * Tests of HashStringCPP::hash64() and the content hashes / digest of QSRepositoryCpp
+ * ************************************************************************************************/
+
+namespace {
+
+//! Creates an object with a given UUID, so separate repos can hold the same objects
+TestObject *createObjectWithUuid(QSRepositoryCpp &repo, const QString &uuidStr, int value)
+{
+    TestObject *qsObject = new TestObject();
+
+    qsObject->setProperty("_qsUuid", uuidStr);
+    qsObject->setProperty("value", value);
+    qsObject->setParent(&repo);
+    qsObject->setProperty("_qsRepo", QVariant::fromValue(&repo));
+
+    return qsObject;
+}
+
+}
+
+TEST_CASE("hash64 matches the XXH64 reference vectors", "[hash]")
+{
+    // Short inputs (tail only) and long inputs (32 byte stripes)
+    CHECK(HashStringCPP::toHex64(HashStringCPP::hash64(""))    == "ef46db3751d8e999");
+    CHECK(HashStringCPP::toHex64(HashStringCPP::hash64("a"))   == "d24ec4f1a98c6e5b");
+    CHECK(HashStringCPP::toHex64(HashStringCPP::hash64("abc")) == "44bc2cf5ad770999");
+    CHECK(HashStringCPP::toHex64(HashStringCPP::hash64("Nobody inspects the spammish repetition"))
+          == "fbcea83c8a378bf1");
+    CHECK(HashStringCPP::toHex64(HashStringCPP::hash64("The quick brown fox jumps over the lazy dog"))
+          == "0b242d361fda71bc");
+}
+
+TEST_CASE("Content hashes follow the serialized properties", "[hash]")
+{
+    TestRepository repo;
+    TestObject *qsObject = createObject(repo, 1);
+    const QString uuidStr = qsObject->getUuidStr();
+
+    const QString initialHash = repo.getContentHash(uuidStr);
+    REQUIRE(initialHash.size() == 16);
+
+    repo.markPersisted();
+    CHECK_FALSE(repo.isObjectChanged(uuidStr));
+
+    SECTION("Changes alter the hash") {
+        qsObject->setProperty("value", 2);
+
+        CHECK(repo.getContentHash(uuidStr) != initialHash);
+        CHECK(repo.isObjectChanged(uuidStr));
+        CHECK(repo.getChangedObjectIds() == QStringList { uuidStr });
+    }
+
+    SECTION("Changing values back is not a change") {
+        qsObject->setProperty("value", 2);
+        qsObject->setProperty("value", 1);
+
+        CHECK(repo.getContentHash(uuidStr) == initialHash);
+        CHECK_FALSE(repo.isObjectChanged(uuidStr));
+    }
+
+    SECTION("Deleted objects have no hash") {
+        repo.delObject(uuidStr);
+
+        CHECK(repo.getContentHash(uuidStr).isEmpty());
+    }
+}
+
+TEST_CASE("Repo digests compare repos bucket by bucket", "[hash]")
+{
+    TestRepository lhs;
+    TestRepository rhs;
+
+    QList<TestObject*> lhsObjects;
+    QList<TestObject*> rhsObjects;
+    for (int i = 0; i < 20; ++i) {
+        const QString uuidStr = QUuid::createUuid().toString();
+
+        lhsObjects.append(createObjectWithUuid(lhs, uuidStr, i));
+        rhsObjects.append(createObjectWithUuid(rhs, uuidStr, i));
+    }
+
+    REQUIRE(lhs.getRepoDigest() == rhs.getRepoDigest());
+    REQUIRE(lhs.getDigestBuckets() == rhs.getDigestBuckets());
+
+    SECTION("A change alters the digest and a single bucket") {
+        rhsObjects.at(7)->setProperty("label", "changed");
+
+        CHECK(lhs.getRepoDigest() != rhs.getRepoDigest());
+
+        const QStringList lhsBuckets = lhs.getDigestBuckets();
+        const QStringList rhsBuckets = rhs.getDigestBuckets();
+
+        int differentBuckets = 0;
+        for (int i = 0; i < lhsBuckets.size(); ++i) {
+            differentBuckets += lhsBuckets.at(i) != rhsBuckets.at(i) ? 1 : 0;
+        }
+        CHECK(differentBuckets == 1);
+    }
+
+    SECTION("Equal content gives equal digests again") {
+        rhsObjects.at(7)->setProperty("label", "changed");
+        lhsObjects.at(7)->setProperty("label", "changed");
+
+        CHECK(lhs.getRepoDigest() == rhs.getRepoDigest());
+    }
+}
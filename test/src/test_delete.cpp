@@ -0,0 +1,134 @@
+#include <catch2/catch.hpp>
+
+#include "TestObjects.h"
+
+#include <QSignalSpy>
+
+/*! ***********************************************************************************************
+ * Tests of bulk deletion (QSRepositoryCpp::delObjects(), clearObjects()) and the pending changes
+ * ************************************************************************************************/
+
+TEST_CASE("Deleting several objects emits a single signal", "[delete]")
+{
+    TestRepository     repo;
+    QList<TestObject*> qsObjects;
+    for (int i = 0; i < 4; ++i) { qsObjects.append(createObject(repo, i)); }
+
+    QSignalSpy deletedSpy       (&repo, &QSRepositoryCpp::objectDeleted);
+    QSignalSpy bulkDeletedSpy   (&repo, &QSRepositoryCpp::objectsDeleted);
+    QSignalSpy objectsChangedSpy(&repo, &QSRepositoryCpp::objectsChanged);
+    QSignalSpy pendingChangedSpy(&repo, &QSRepositoryCpp::deletedObjectsChanged);
+
+    SECTION("Several objects") {
+        const QStringList uuidStrs { qsObjects[0]->getUuidStr(), qsObjects[1]->getUuidStr(),
+                                     qsObjects[2]->getUuidStr() };
+
+        REQUIRE(repo.delObjects(uuidStrs));
+
+        CHECK(deletedSpy.isEmpty());
+        REQUIRE(bulkDeletedSpy.size() == 1);
+        CHECK(bulkDeletedSpy.first().first().toStringList() == uuidStrs);
+        CHECK(objectsChangedSpy.size() == 1);
+        CHECK(pendingChangedSpy.size() == 1);
+
+        CHECK(repo.getDeletedObjects().size() == 3);
+        CHECK(repo.getAddedObjects() == QVariantList { QVariant::fromValue(qsObjects[3]) });
+    }
+
+    SECTION("A single object") {
+        REQUIRE(repo.delObjects({ qsObjects[0]->getUuidStr() }));
+
+        CHECK(deletedSpy.size() == 1);
+        CHECK(bulkDeletedSpy.isEmpty());
+    }
+
+    SECTION("Unknown objects") {
+        CHECK_FALSE(repo.delObjects({ QUuid::createUuid().toString() }));
+
+        CHECK(deletedSpy.isEmpty());
+        CHECK(bulkDeletedSpy.isEmpty());
+        CHECK(objectsChangedSpy.isEmpty());
+    }
+}
+
+TEST_CASE("Deleted objects are removed from all indices", "[delete]")
+{
+    TestRepository repo;
+    REQUIRE(repo.addPropertyIndex("value"));
+
+    TestObject *referrer = createObject(repo, 1);
+    TestObject *target   = createObject(repo, 1);
+    TestObject *other    = createObject(repo, 2);
+
+    referrer->setProperty("target", QVariant::fromValue<QSObjectCpp*>(target));
+
+    REQUIRE(repo.getReferrers(target->getUuidStr()) == QStringList { referrer->getUuidStr() });
+    REQUIRE(repo.getUpdatedObjects().contains(QVariant::fromValue(referrer)));
+
+    REQUIRE(repo.delObjects({ referrer->getUuidStr(), other->getUuidStr() }));
+
+    // Type and property indices
+    CHECK(repo.countObjectsByType("TestObject") == 1);
+    CHECK(repo.findObjectsByProperty("value", 1) == QVariantList { QVariant::fromValue(target) });
+    CHECK(repo.findObjectsByProperty("value", 2).isEmpty());
+
+    // References held by deleted objects
+    CHECK(repo.getReferences(referrer->getUuidStr()).isEmpty());
+    CHECK_FALSE(repo.isReferenced(target->getUuidStr()));
+
+    // Pending changes
+    CHECK_FALSE(repo.getUpdatedObjects().contains(QVariant::fromValue(referrer)));
+    CHECK(repo.getAddedObjects() == QVariantList { QVariant::fromValue(target) });
+}
+
+TEST_CASE("Clearing the repo removes all objects at once", "[delete]")
+{
+    TestRepository repo;
+    for (int i = 0; i < 10; ++i) { createObject(repo, i); }
+
+    QSignalSpy deletedSpy    (&repo, &QSRepositoryCpp::objectDeleted);
+    QSignalSpy bulkDeletedSpy(&repo, &QSRepositoryCpp::objectsDeleted);
+
+    REQUIRE(repo.clearObjects());
+
+    CHECK(deletedSpy.isEmpty());
+    REQUIRE(bulkDeletedSpy.size() == 1);
+    CHECK(bulkDeletedSpy.first().first().toStringList().size() == 10);
+
+    CHECK(repo.getObjectTypes().isEmpty());
+    CHECK(repo.getAddedObjects().isEmpty());
+    CHECK(repo.getUpdatedObjects().isEmpty());
+    CHECK(repo.getDeletedObjects().size() == 10);
+
+    // Nothing left to clear
+    CHECK_FALSE(repo.clearObjects());
+}
+
+TEST_CASE("Pending changes keep their order when entries are removed", "[delete]")
+{
+    TestRepository repo;
+    QVariantList   remaining;
+
+    for (int i = 0; i < 10; ++i) {
+        TestObject *qsObject = createObject(repo, i);
+
+        if (i % 2 == 0) {
+            repo.delObject(qsObject->getUuidStr());
+        } else {
+            remaining.append(QVariant::fromValue(qsObject));
+        }
+    }
+
+    CHECK(repo.getAddedObjects() == remaining);
+    CHECK(repo.getDeletedObjects().size() == 5);
+
+    // Adding an object again removes it from the deleted objects
+    const QString uuidStr = repo.getDeletedObjects().first().toString();
+    TestObject   *qsObject = new TestObject();
+    qsObject->setParent(&repo);
+    qsObject->setProperty("_qsUuid", uuidStr);
+    REQUIRE(repo.addObject(uuidStr, qsObject));
+
+    CHECK(repo.getDeletedObjects().size() == 4);
+    CHECK_FALSE(repo.getDeletedObjects().contains(uuidStr));
+}
@@ -0,0 +1,103 @@
+#include <catch2/catch.hpp>
+
+#include "TestObjects.h"
+
+#include <QPointer>
+#include <QSignalSpy>
+
+/*! ***********************************************************************************************
+ * Tests of QSGarbageCollectorCpp
+ * ************************************************************************************************/
+
+namespace {
+
+void setTarget(TestObject *referrer, QSObjectCpp *target)
+{
+    referrer->setProperty("target", QVariant::fromValue(target));
+}
+
+}
+
+TEST_CASE("Unreachable objects are collected", "[gc]")
+{
+    TestRepository repo;
+    TestObject *root        = createObject(repo);
+    TestObject *reachable   = createObject(repo);
+    TestObject *unreachable = createObject(repo);
+
+    repo.setProperty("qsRootObject", QVariant::fromValue<QSObjectCpp*>(root));
+    setTarget(root, reachable);
+
+    QSGarbageCollectorCpp *collector = repo.getCollector();
+
+    SECTION("Reporting only") {
+        CHECK(collector->collect() == QStringList { unreachable->getUuidStr() });
+        CHECK(repo.getObject(unreachable->getUuidStr()) == unreachable);
+    }
+
+    SECTION("Deleting") {
+        QSignalSpy           finishedSpy(collector, &QSGarbageCollectorCpp::finished);
+        QPointer<TestObject> collected = unreachable;
+
+        CHECK(collector->collect(true) == QStringList { unreachable->getUuidStr() });
+
+        REQUIRE(finishedSpy.size() == 1);
+        CHECK(finishedSpy.first().at(1).toInt() == 1);
+        CHECK(repo.getObject(collected->getUuidStr()) == nullptr);
+
+        processEvents();
+        CHECK(collected.isNull());
+        CHECK(repo.getObject(reachable->getUuidStr()) == reachable);
+    }
+
+    SECTION("Pinned objects are roots") {
+        collector->pin(unreachable->getUuidStr());
+
+        CHECK(collector->collect().isEmpty());
+    }
+
+    SECTION("Collecting requires a root") {
+        repo.setProperty("qsRootObject", QVariant::fromValue<QSObjectCpp*>(nullptr));
+
+        CHECK_FALSE(collector->start());
+        CHECK(collector->collect().isEmpty());
+    }
+}
+
+TEST_CASE("Incremental collections see changes made while running", "[gc]")
+{
+    TestRepository repo;
+    TestObject *root    = createObject(repo);
+    TestObject *dropped = createObject(repo);
+    TestObject *target  = createObject(repo);
+
+    repo.setProperty("qsRootObject", QVariant::fromValue<QSObjectCpp*>(root));
+    setTarget(root, dropped);
+
+    QSGarbageCollectorCpp *collector = repo.getCollector();
+    QSignalSpy finishedSpy(collector, &QSGarbageCollectorCpp::finished);
+
+    REQUIRE(collector->start());
+    REQUIRE(collector->isRunning());
+
+    // Write barrier: targets referenced while marking survive, even by objects that are not marked
+    TestObject *added = createObject(repo);
+    setTarget(added, target);
+
+    // Dropped references are only seen by the next collection
+    setTarget(root, nullptr);
+
+    REQUIRE(finishedSpy.wait(1000));
+    CHECK_FALSE(collector->isRunning());
+
+    const QStringList unreachableIds = collector->getUnreachableIds();
+    CHECK_FALSE(unreachableIds.contains(target->getUuidStr()));
+    CHECK_FALSE(unreachableIds.contains(added->getUuidStr()));   // added while collecting
+    CHECK_FALSE(unreachableIds.contains(root->getUuidStr()));
+
+    // The next collection finds all garbage
+    const QStringList nextIds = collector->collect();
+    CHECK(nextIds.contains(dropped->getUuidStr()));
+    CHECK(nextIds.contains(added->getUuidStr()));
+    CHECK(nextIds.contains(target->getUuidStr()));
+}
@@ -0,0 +1,109 @@
+#include <catch2/catch.hpp>
+
+#include "TestObjects.h"
+#include "QtQuickStream/Core/QSSerializerCpp.h"
+
+#include <QPointer>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+
+/*! ***********************************************************************************************
+ * Tests of indexed files (QSIndexedFileCpp) and on-demand loading of QSRepositoryCpp
+ * ************************************************************************************************/
+
+TEST_CASE("Indexed files store single objects", "[indexed]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString fileName = dir.filePath("repo.qqs");
+
+    const QVariantMap object { { "qsType", "TestObject" }, { "value", 42 } };
+    const QHash<QString, QByteArray> objects {
+        { "{a}", QSSerializerCpp::toCompactJson(object) },
+        { "{b}", QSSerializerCpp::toCompactJson(QVariantMap { { "value", 1 } }) }
+    };
+
+    REQUIRE(QSIndexedFileCpp::write(fileName, { { "root", "qqs:/{a}" } }, objects));
+    REQUIRE(QSIndexedFileCpp::isIndexedFile(fileName));
+
+    QSIndexedFileCpp indexedFile;
+    REQUIRE(indexedFile.open(fileName));
+
+    CHECK(indexedFile.meta().value("root").toString() == "qqs:/{a}");
+    CHECK(indexedFile.contains("{b}"));
+    CHECK_FALSE(indexedFile.contains("{c}"));
+    CHECK(indexedFile.read("{a}").value("value").toInt() == 42);
+
+    SECTION("Evicted objects are read from the swap file") {
+        const QVariantMap changed { { "qsType", "TestObject" }, { "value", 7 } };
+
+        REQUIRE(indexedFile.evict("{a}", changed));
+
+        CHECK(indexedFile.isSwapped("{a}"));
+        CHECK_FALSE(indexedFile.isSwapped("{b}"));
+        CHECK(indexedFile.read("{a}").value("value").toInt() == 7);
+    }
+}
+
+TEST_CASE("Repos page objects in and out of indexed files", "[indexed]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString fileName = dir.filePath("repo.qqs");
+
+    TestRepository repo;
+    TestObject *referrer = createObject(repo, 1);
+    TestObject *target   = createObject(repo, 2);
+    TestObject *other    = createObject(repo, 3);
+
+    referrer->setProperty("target", QVariant::fromValue<QSObjectCpp*>(target));
+
+    REQUIRE(repo.writeIndexedFile(fileName, repo.snapshot().dump()));
+    REQUIRE(repo.isIndexedFileOpen());
+    CHECK(repo.getPagedOutIds().isEmpty());
+
+    SECTION("Referenced objects are not evicted alone") {
+        CHECK(repo.evictObjects({ target->getUuidStr() }).isEmpty());
+        CHECK(repo.getObject(target->getUuidStr()) == target);
+    }
+
+    SECTION("Subgraphs are evicted together") {
+        QSignalSpy evictedSpy(&repo, &QSRepositoryCpp::objectsEvicted);
+
+        const QString referrerId = referrer->getUuidStr();
+        const QString targetId   = target->getUuidStr();
+        QPointer<TestObject> evictedObject = referrer;
+
+        const QStringList evictedIds = repo.evictObjects({ referrerId, targetId });
+
+        CHECK(evictedIds.size() == 2);
+        CHECK(evictedSpy.size() == 1);
+        CHECK(repo.getObject(referrerId) == nullptr);
+        CHECK(repo.isPagedOut(referrerId));
+        CHECK(repo.isPagedOut(targetId));
+
+        // Evicted objects are not deleted from the repo's point of view
+        CHECK_FALSE(repo.getDeletedObjects().contains(referrerId));
+
+        processEvents();
+        CHECK(evictedObject.isNull());
+
+        // Only requested objects are read, unless references are followed
+        CHECK(repo.readIndexedObjects({ referrerId }, false).keys() == QStringList { referrerId });
+
+        const QVariantMap jsonObjects = repo.readIndexedObjects({ referrerId });
+        CHECK(jsonObjects.size() == 2);
+        CHECK(jsonObjects.value(referrerId).toMap().value("target").toString()
+              == QSSerializerCpp::protoString + targetId);
+    }
+
+    SECTION("Objects owned elsewhere are not evicted") {
+        QObject owner;
+        other->setParent(&owner);
+
+        CHECK(repo.evictObjects({ other->getUuidStr() }).isEmpty());
+        CHECK(repo.getObject(other->getUuidStr()) == other);
+
+        other->setParent(&repo);
+    }
+}
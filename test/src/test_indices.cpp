@@ -0,0 +1,75 @@
+#include <catch2/catch.hpp>
+
+#include "TestObjects.h"
+
+/*! ***********************************************************************************************
+ * Tests of the secondary indices of QSRepositoryCpp (by type and by property value)
+ * ************************************************************************************************/
+
+//! Second type, to tell types apart in the type index
+class OtherTestObject : public TestObject
+{
+    Q_OBJECT
+
+public:
+    using TestObject::TestObject;
+};
+
+TEST_CASE("Objects are indexed by type", "[indices]")
+{
+    TestRepository repo;
+    TestObject      *first  = createObject(repo);
+    createObject(repo);
+    OtherTestObject *other  = createObject<OtherTestObject>(repo);
+
+    CHECK(repo.getObjectTypes().size() == 2);
+    CHECK(repo.countObjectsByType("TestObject") == 2);
+    CHECK(repo.findObjectsByType("OtherTestObject") == QVariantList { QVariant::fromValue(other) });
+    CHECK(repo.findObjectsByType("Unknown").isEmpty());
+
+    repo.delObject(other->getUuidStr());
+    repo.delObject(first->getUuidStr());
+
+    CHECK(repo.getObjectTypes() == QStringList { "TestObject" });
+    CHECK(repo.countObjectsByType("TestObject") == 1);
+}
+
+TEST_CASE("Objects are indexed by property value", "[indices]")
+{
+    TestRepository repo;
+    TestObject *first  = createObject(repo, 1);
+    TestObject *second = createObject(repo, 2);
+    TestObject *target = createObject(repo, 3);
+
+    REQUIRE(repo.addPropertyIndex("value"));
+    REQUIRE(repo.addPropertyIndex("target"));
+    CHECK_FALSE(repo.addPropertyIndex("value"));
+
+    CHECK(repo.findObjectsByProperty("value", 1) == QVariantList { QVariant::fromValue(first) });
+
+    SECTION("Changes are indexed") {
+        second->setProperty("value", 1);
+
+        CHECK(repo.findObjectsByProperty("value", 1).size() == 2);
+        CHECK(repo.findObjectsByProperty("value", 2).isEmpty());
+    }
+
+    SECTION("Objects match by reference") {
+        first->setProperty("target", QVariant::fromValue<QSObjectCpp*>(target));
+
+        const QVariantList referrers = repo.findObjectsByProperty(
+                                           "target", QVariant::fromValue<QSObjectCpp*>(target));
+        CHECK(referrers == QVariantList { QVariant::fromValue(first) });
+    }
+
+    SECTION("Unindexed properties are scanned") {
+        REQUIRE(repo.removePropertyIndex("value"));
+        CHECK(repo.getPropertyIndices() == QStringList { "target" });
+
+        second->setProperty("value", 1);
+
+        CHECK(repo.findObjectsByProperty("value", 1).size() == 2);
+    }
+}
+
+#include "test_indices.moc"
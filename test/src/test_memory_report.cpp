@@ -0,0 +1,80 @@
+#include <catch2/catch.hpp>
+
+#include "TestObjects.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+/*! ***********************************************************************************************
+ * Tests of QSRepositoryCpp::getMemoryReport()
+ * ************************************************************************************************/
+
+//! Second type, to tell types apart in the report
+class ReportTestObject : public TestObject
+{
+    Q_OBJECT
+
+public:
+    using TestObject::TestObject;
+};
+
+namespace {
+
+qint64 bytesOf(const QVariantMap &report, const QString &qsType, const QString &part)
+{
+    return report.value("types").toMap().value(qsType).toMap()
+                 .value("bytes").toMap().value(part).toLongLong();
+}
+
+}
+
+TEST_CASE("Memory reports break down the footprint by type", "[memory]")
+{
+    TestRepository repo;
+    for (int i = 0; i < 3; ++i) { createObject(repo, i); }
+    ReportTestObject *other = createObject<ReportTestObject>(repo);
+
+    const QVariantMap report = repo.getMemoryReport();
+    const QVariantMap types  = report.value("types").toMap();
+
+    CHECK(report.value("objects").toInt() == 4);
+    CHECK(types.value("TestObject").toMap().value("count").toInt() == 3);
+    CHECK(types.value("ReportTestObject").toMap().value("count").toInt() == 1);
+
+    SECTION("Totals are the sum of all types") {
+        qint64 typeTotal = 0;
+        for (const QVariant &type : types) {
+            typeTotal += type.toMap().value("bytes").toMap().value("total").toLongLong();
+        }
+
+        const qint64 total = report.value("totals").toMap().value("total").toLongLong();
+
+        CHECK(total > 0);
+        CHECK(typeTotal == total);
+        CHECK(report.value("totalBytes").toLongLong()
+              == total + report.value("repository").toMap().value("total").toLongLong());
+    }
+
+    SECTION("Larger values and indices are accounted for") {
+        other->setProperty("label", QString(1000, QLatin1Char('x')));
+        REQUIRE(repo.addPropertyIndex("label"));
+
+        const QVariantMap after = repo.getMemoryReport();
+
+        CHECK(bytesOf(after, "ReportTestObject", "properties")
+              >= bytesOf(report, "ReportTestObject", "properties") + 1000);
+        CHECK(bytesOf(after, "TestObject", "bookkeeping")
+              > bytesOf(report, "TestObject", "bookkeeping"));
+        CHECK(bytesOf(after, "TestObject", "properties")
+              == bytesOf(report, "TestObject", "properties"));
+    }
+
+    SECTION("The report can be logged as JSON") {
+        const QJsonDocument json = QJsonDocument::fromJson(repo.getMemoryReportJson().toUtf8());
+
+        REQUIRE(json.isObject());
+        CHECK(json.object().value("objects").toInt() == 4);
+    }
+}
+
+#include "test_memory_report.moc"
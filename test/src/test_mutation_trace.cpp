@@ -0,0 +1,119 @@
+#include <catch2/catch.hpp>
+
+#include "TestObjects.h"
+#include "QtQuickStream/Core/QSMutationReplayer.h"
+#include "QtQuickStream/Core/QSSerializerCpp.h"
+
+#include <QTemporaryDir>
+
+#include <thread>
+#include <vector>
+
+/*! ***********************************************************************************************
+ * Tests of mutation traces (QSMutationRecorderCpp) and replaying them (QSMutationReplayer)
+ * ************************************************************************************************/
+
+namespace {
+
+//! Returns the stored state of all objects of repo (as compact JSON, by UUID)
+QMap<QString, QByteArray> storedState(const QSRepositoryCpp &repo)
+{
+    QMap<QString, QByteArray> state;
+
+    const QVariantMap objects = repo.property("_qsObjects").toMap();
+    for (auto it = objects.cbegin(); it != objects.cend(); ++it) {
+        state.insert(it.key(), QSSerializerCpp::toCompactJson(
+                                   QSSerializerCpp::getQSProps(it.value().value<QSObjectCpp*>())));
+    }
+
+    return state;
+}
+
+//! Replays the trace into a new repo, and returns its final state
+QMap<QString, QByteArray> replayTrace(const QString &fileName, QVariantMap *stats = nullptr)
+{
+    QSMutationReplayer replayer;
+    if (!replayer.load(fileName)) { return {}; }
+
+    replayer.setFactory([](const QString &) -> QSObjectCpp* { return new TestObject(); });
+
+    QSRepositoryCpp repo;
+    const QVariantMap replayStats = replayer.replay(&repo);
+    if (stats != nullptr) { *stats = replayStats; }
+
+    return storedState(repo);
+}
+
+}
+
+TEST_CASE("Replaying a trace restores the recorded session", "[trace]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString fileName = dir.filePath("session.qqstrace");
+
+    TestRepository repo;
+    TestObject *first  = createObject(repo, 1);
+    TestObject *second = createObject(repo, 2);
+
+    // Session: add, change (values and references) and delete
+    QSMutationRecorderCpp *recorder = repo.getRecorder();
+    REQUIRE(recorder->start(fileName));
+
+    TestObject *added = createObject(repo, 3);
+    added->setProperty("target", QVariant::fromValue<QSObjectCpp*>(first));
+    first->setProperty("value", 10);
+    second->setProperty("label", "changed");
+    repo.delObject(second->getUuidStr());
+
+    recorder->stop();
+    REQUIRE(recorder->getEventCount() == 5);
+
+    const QMap<QString, QByteArray> recordedState = storedState(repo);
+
+    SECTION("Final state") {
+        QVariantMap stats;
+        const QMap<QString, QByteArray> replayedState = replayTrace(fileName, &stats);
+
+        CHECK(replayedState == recordedState);
+        CHECK(stats.value("operations").toInt() == 5);
+        CHECK(stats.value("skipped").toInt() == 0);
+        CHECK(stats.value("kinds").toMap().value("change").toMap().value("count").toInt() == 3);
+    }
+
+    SECTION("Concurrent replays (qqstool replay --jobs)") {
+        constexpr int jobCount = 4;
+
+        std::vector<QMap<QString, QByteArray>> replayedStates(jobCount);
+        std::vector<std::thread>               jobs;
+        for (int i = 0; i < jobCount; ++i) {
+            jobs.emplace_back([&fileName, &replayedStates, i]() {
+                replayedStates[i] = replayTrace(fileName);
+            });
+        }
+        for (std::thread &job : jobs) { job.join(); }
+
+        for (const QMap<QString, QByteArray> &replayedState : std::as_const(replayedStates)) {
+            CHECK(replayedState == recordedState);
+        }
+    }
+}
+
+TEST_CASE("Invalid traces are rejected", "[trace]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString fileName = dir.filePath("invalid.qqstrace");
+
+    QFile file(fileName);
+    REQUIRE(file.open(QFile::WriteOnly));
+    file.write("{ \"name\": \"Repo\" }\n");
+    file.close();
+
+    QSMutationReplayer replayer;
+    QString            errorString;
+
+    CHECK_FALSE(replayer.load(fileName, &errorString));
+    CHECK_FALSE(errorString.isEmpty());
+    CHECK_FALSE(replayer.load(dir.filePath("missing.qqstrace"), &errorString));
+}
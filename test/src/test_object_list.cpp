@@ -0,0 +1,167 @@
+#include <catch2/catch.hpp>
+
+#include "TestObjects.h"
+#include "QtQuickStream/Core/QSObjectListCpp.h"
+
+#include <QSignalSpy>
+
+/*! ***********************************************************************************************
+ * Tests of QSObjectListCpp (ordered child containers and their model signals)
+ * ************************************************************************************************/
+
+namespace {
+
+QVariantList toVariantList(const QList<TestObject*> &elements)
+{
+    QVariantList variantList;
+    for (TestObject *element : elements) { variantList.append(QVariant::fromValue(element)); }
+
+    return variantList;
+}
+
+}
+
+TEST_CASE("Elements are attached to the owner", "[objectlist]")
+{
+    TestRepository  repo;
+    TestObject     *owner = createObject(repo);
+    QSObjectListCpp list;
+    list.setOwner(owner);
+
+    TestObject *first  = new TestObject();
+    TestObject *second = new TestObject();
+
+    REQUIRE(list.append(first));
+    REQUIRE(list.insert(0, second));
+    CHECK_FALSE(list.append(first));
+
+    CHECK(list.getElements() == toVariantList({ second, first }));
+    CHECK(list.getByUuid(first->getUuidStr()) == first);
+    CHECK(first->parent() == owner);
+    CHECK(first->getRepo() == &repo);
+    CHECK(repo.getObject(first->getUuidStr()) == first);
+
+    REQUIRE(list.remove(first));
+
+    CHECK(list.count() == 1);
+    CHECK_FALSE(list.contains(first));
+    CHECK(first->parent() == nullptr);
+    CHECK(first->getRepo() == nullptr);
+
+    delete first;
+}
+
+TEST_CASE("setElements() only signals the rows that changed", "[objectlist]")
+{
+    TestRepository  repo;
+    TestObject     *owner = createObject(repo);
+    QSObjectListCpp list;
+    list.setOwner(owner);
+
+    QList<TestObject*> elements;
+    for (int i = 0; i < 40; ++i) {
+        elements.append(new TestObject());
+        list.append(elements.last());
+    }
+
+    QSignalSpy insertedSpy(&list, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removedSpy (&list, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy movedSpy   (&list, &QAbstractItemModel::rowsMoved);
+    QSignalSpy resetSpy   (&list, &QAbstractItemModel::modelReset);
+
+    SECTION("Moving a single element") {
+        QList<TestObject*> newElements = elements;
+        newElements.move(30, 1);
+
+        list.setElements(toVariantList(newElements));
+
+        CHECK(list.getElements() == toVariantList(newElements));
+        CHECK(movedSpy.size() == 1);
+        CHECK(insertedSpy.isEmpty());
+        CHECK(removedSpy.isEmpty());
+        CHECK(resetSpy.isEmpty());
+    }
+
+    SECTION("Removing and inserting runs of rows") {
+        QList<TestObject*> newElements = elements.mid(0, 2) + elements.mid(5);
+        newElements.insert(1, new TestObject());
+        newElements.insert(2, new TestObject());
+
+        list.setElements(toVariantList(newElements));
+
+        CHECK(list.getElements() == toVariantList(newElements));
+        REQUIRE(removedSpy.size() == 1);
+        CHECK(removedSpy.first().at(1).toInt() == 2);   // first row
+        CHECK(removedSpy.first().at(2).toInt() == 4);   // last row
+        REQUIRE(insertedSpy.size() == 1);
+        CHECK(insertedSpy.first().at(1).toInt() == 1);
+        CHECK(insertedSpy.first().at(2).toInt() == 2);
+        CHECK(movedSpy.isEmpty());
+        CHECK(resetSpy.isEmpty());
+
+        CHECK(newElements.at(1)->parent() == owner);
+        CHECK(elements.at(3)->parent() == nullptr);
+    }
+
+    SECTION("Large changes reset the model") {
+        // Reversing takes a move per element
+        QList<TestObject*> newElements(elements.crbegin(), elements.crend());
+        newElements.prepend(new TestObject());
+
+        list.setElements(toVariantList(newElements));
+
+        CHECK(list.getElements() == toVariantList(newElements));
+        CHECK(resetSpy.size() == 1);
+        for (TestObject *element : std::as_const(newElements)) {
+            CHECK(list.getByUuid(element->getUuidStr()) == element);
+        }
+    }
+
+    SECTION("Unchanged elements signal nothing") {
+        list.setElements(toVariantList(elements));
+
+        CHECK(insertedSpy.isEmpty());
+        CHECK(removedSpy.isEmpty());
+        CHECK(movedSpy.isEmpty());
+        CHECK(resetSpy.isEmpty());
+    }
+}
+
+TEST_CASE("Destroyed elements are removed", "[objectlist]")
+{
+    TestRepository  repo;
+    TestObject     *owner = createObject(repo);
+    QSObjectListCpp list;
+    list.setOwner(owner);
+
+    QList<TestObject*> elements;
+    for (int i = 0; i < 4; ++i) {
+        elements.append(new TestObject());
+        list.append(elements.last());
+    }
+
+    QSignalSpy removedSpy(&list, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy resetSpy  (&list, &QAbstractItemModel::modelReset);
+
+    SECTION("Single element") {
+        const QString uuidStr = elements.at(2)->getUuidStr();
+        repo.delObject(uuidStr);
+        delete elements.at(2);
+
+        CHECK(list.count() == 3);
+        CHECK(list.getByUuid(uuidStr) == nullptr);
+        CHECK(removedSpy.size() == 1);
+    }
+
+    SECTION("Children of a destroyed owner are dropped at once") {
+        QStringList uuidStrs { owner->getUuidStr() };
+        for (TestObject *element : std::as_const(elements)) { uuidStrs.append(element->getUuidStr()); }
+
+        repo.delObjects(uuidStrs);
+        delete owner;
+
+        CHECK(list.count() == 0);
+        CHECK(resetSpy.size() == 1);
+        CHECK(removedSpy.isEmpty());
+    }
+}
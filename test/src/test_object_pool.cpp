@@ -0,0 +1,150 @@
+#include <catch2/catch.hpp>
+
+#include "TestObjects.h"
+#include "QtQuickStream/Core/QSObjectPoolCpp.h"
+
+/*! ***********************************************************************************************
+ * Tests of QSObjectPoolCpp (reusing objects when reloading a repository)
+ * ************************************************************************************************/
+
+//! Counts its instantiations
+class CountedTestObject : public TestObject
+{
+    Q_OBJECT
+
+public:
+    explicit CountedTestObject(QObject *parent = nullptr) : TestObject(parent) { ++instances; }
+
+    static inline int instances = 0;
+};
+
+namespace {
+
+/*! Loads objects like QSRepository.loadQSObjects(): parked objects are acquired before new ones
+ *  are instantiated, then the loaded properties are written
+ * ************************************************************************************************/
+QList<CountedTestObject*> loadObjects(QSRepositoryCpp &repo, const QList<QVariantMap> &jsonObjects)
+{
+    QSObjectPoolCpp *objectPool = repo.getObjectPool();
+
+    QList<CountedTestObject*> qsObjects;
+    for (const QVariantMap &jsonObj : jsonObjects) {
+        auto *qsObject = qobject_cast<CountedTestObject*>(
+                             objectPool->acquire("CountedTestObject", jsonObj));
+
+        if (qsObject == nullptr) {
+            qsObject = new CountedTestObject();
+            objectPool->captureDefaults(qsObject);
+        }
+
+        qsObject->setParent(&repo);
+        qsObject->setProperty("_qsRepo", QVariant::fromValue(&repo));
+
+        for (auto it = jsonObj.cbegin(); it != jsonObj.cend(); ++it) {
+            if (it.key() != "qsType") { qsObject->setProperty(qPrintable(it.key()), it.value()); }
+        }
+
+        qsObjects.append(qsObject);
+    }
+
+    return qsObjects;
+}
+
+//! Deletes objects like QSRepository.loadRepo(), and offers them to the pool
+void unloadObjects(TestRepository &repo, const QList<CountedTestObject*> &qsObjects)
+{
+    QStringList uuidStrs;
+    for (const CountedTestObject *qsObject : qsObjects) { uuidStrs.append(qsObject->getUuidStr()); }
+
+    repo.delObjects(uuidStrs);
+
+    for (CountedTestObject *qsObject : qsObjects) {
+        if (!repo.getObjectPool()->recycle(qsObject)) { delete qsObject; }
+    }
+}
+
+}
+
+TEST_CASE("Reloading reuses pooled objects instead of instantiating them", "[pool]")
+{
+    TestRepository repo;
+    repo.getObjectPool()->setEnabled(true);
+
+    QList<QVariantMap> jsonObjects;
+    for (int i = 0; i < 10; ++i) {
+        jsonObjects.append({ { "qsType", "CountedTestObject" }, { "qsIsAvailable", true },
+                             { "value", i }, { "label", QString::number(i) } });
+    }
+
+    const int instancesBefore = CountedTestObject::instances;
+    QList<CountedTestObject*> qsObjects = loadObjects(repo, jsonObjects);
+    REQUIRE(CountedTestObject::instances - instancesBefore == 10);
+
+    for (int reload = 0; reload < 3; ++reload) {
+        unloadObjects(repo, qsObjects);
+        REQUIRE(repo.getObjectPool()->size() == 10);
+
+        qsObjects = loadObjects(repo, jsonObjects);
+    }
+
+    // Only the first load instantiated objects
+    CHECK(CountedTestObject::instances - instancesBefore == 10);
+    CHECK(repo.getObjectPool()->getHits() == 30);
+    CHECK(repo.getObjectPool()->size() == 0);
+    CHECK(repo.property("_qsObjects").toMap().size() == 10);
+    CHECK(qsObjects.at(3)->property("value").toInt() == 3);
+}
+
+TEST_CASE("Pooled objects are reset without overwriting loaded values", "[pool]")
+{
+    TestRepository repo;
+    repo.getObjectPool()->setEnabled(true);
+
+    CountedTestObject *qsObject = loadObjects(repo, { { { "qsType", "CountedTestObject" } } }).first();
+    TestObject        *target   = createObject(repo);
+
+    qsObject->setProperty("value", 5);
+    qsObject->setProperty("label", "recycled");
+    qsObject->setProperty("target", QVariant::fromValue<QSObjectCpp*>(target));
+
+    SECTION("References are dropped when recycling, values are kept") {
+        unloadObjects(repo, { qsObject });
+
+        CHECK(qsObject->property("target").value<QSObjectCpp*>() == nullptr);
+        CHECK(qsObject->property("label").toString() == "recycled");
+    }
+
+    SECTION("Properties that are not loaded are reset to their defaults") {
+        unloadObjects(repo, { qsObject });
+
+        QObject *acquired = repo.getObjectPool()->acquire("CountedTestObject", { { "value", 7 } });
+
+        REQUIRE(acquired == qsObject);
+        CHECK(acquired->property("label").toString().isEmpty());
+        CHECK(acquired->property("value").toInt() == 5);   // written by the loader instead
+    }
+
+    SECTION("Referenced objects are not recycled") {
+        TestObject *referrer = createObject(repo);
+        referrer->setProperty("target", QVariant::fromValue<QSObjectCpp*>(qsObject));
+
+        repo.delObject(qsObject->getUuidStr());
+
+        CHECK_FALSE(repo.getObjectPool()->recycle(qsObject));
+        CHECK(repo.getObjectPool()->size() == 0);
+    }
+}
+
+TEST_CASE("Disabled pools keep nothing", "[pool]")
+{
+    TestRepository repo;
+    TestObject *qsObject = createObject(repo);
+
+    repo.getObjectPool()->captureDefaults(qsObject);
+    repo.delObject(qsObject->getUuidStr());
+
+    CHECK_FALSE(repo.getObjectPool()->recycle(qsObject));
+    CHECK(repo.getObjectPool()->acquire("TestObject") == nullptr);
+}
+
+#include "test_object_pool.moc"
@@ -0,0 +1,115 @@
+#include <catch2/catch.hpp>
+
+#include "TestObjects.h"
+
+/*! ***********************************************************************************************
+ * Tests of the reverse reference index of QSRepositoryCpp and of deleteObject()
+ * ************************************************************************************************/
+
+namespace {
+
+void setTarget(TestObject *referrer, QSObjectCpp *target)
+{
+    referrer->setProperty("target", QVariant::fromValue(target));
+}
+
+QSObjectCpp *getTarget(const TestObject *referrer)
+{
+    return referrer->property("target").value<QSObjectCpp*>();
+}
+
+}
+
+TEST_CASE("References are indexed in both directions", "[references]")
+{
+    TestRepository repo;
+    TestObject *referrer = createObject(repo);
+    TestObject *first    = createObject(repo);
+    TestObject *second   = createObject(repo);
+
+    setTarget(referrer, first);
+
+    CHECK(repo.getReferences(referrer->getUuidStr()) == QStringList { first->getUuidStr() });
+    CHECK(repo.getReferrers(first->getUuidStr()) == QStringList { referrer->getUuidStr() });
+    CHECK(repo.isReferenced(first->getUuidStr()));
+
+    setTarget(referrer, second);
+
+    CHECK_FALSE(repo.isReferenced(first->getUuidStr()));
+    CHECK(repo.getReferrers(second->getUuidStr()) == QStringList { referrer->getUuidStr() });
+
+    setTarget(referrer, nullptr);
+
+    CHECK(repo.getReferences(referrer->getUuidStr()).isEmpty());
+    CHECK_FALSE(repo.isReferenced(second->getUuidStr()));
+}
+
+TEST_CASE("Deleting objects applies the reference policy", "[references]")
+{
+    TestRepository repo;
+    TestObject *referrer = createObject(repo);
+    TestObject *target   = createObject(repo);
+    TestObject *leaf     = createObject(repo);
+
+    // referrer -> target -> leaf
+    setTarget(referrer, target);
+    setTarget(target, leaf);
+
+    SECTION("Keep references") {
+        const QStringList deletedIds = repo.deleteObject(target->getUuidStr(),
+                                                         QSRepositoryCpp::KeepReferences);
+
+        CHECK(deletedIds == QStringList { target->getUuidStr() });
+        CHECK(getTarget(referrer) == target);
+        CHECK(repo.getObject(leaf->getUuidStr()) == leaf);
+    }
+
+    SECTION("Null references") {
+        repo.deleteObject(target->getUuidStr(), QSRepositoryCpp::NullReferences);
+
+        CHECK(getTarget(referrer) == nullptr);
+        CHECK(repo.getReferences(referrer->getUuidStr()).isEmpty());
+        CHECK(repo.getObject(leaf->getUuidStr()) == leaf);
+    }
+
+    SECTION("Cascade to unreferenced targets") {
+        const QStringList deletedIds = repo.deleteObject(referrer->getUuidStr(),
+                                                         QSRepositoryCpp::CascadeReferences);
+
+        CHECK(deletedIds.size() == 3);
+        CHECK(repo.getObject(target->getUuidStr()) == nullptr);
+        CHECK(repo.getObject(leaf->getUuidStr()) == nullptr);
+    }
+
+    SECTION("Cascade stops at objects referenced from elsewhere") {
+        TestObject *other = createObject(repo);
+        setTarget(other, leaf);
+
+        const QStringList deletedIds = repo.deleteObject(referrer->getUuidStr(),
+                                                         QSRepositoryCpp::CascadeReferences);
+
+        CHECK(deletedIds.size() == 2);
+        CHECK(repo.getObject(leaf->getUuidStr()) == leaf);
+        CHECK(repo.getReferrers(leaf->getUuidStr()) == QStringList { other->getUuidStr() });
+    }
+
+    SECTION("Cascade never deletes the root object") {
+        repo.setProperty("qsRootObject", QVariant::fromValue<QSObjectCpp*>(leaf));
+
+        const QStringList deletedIds = repo.deleteObject(referrer->getUuidStr(),
+                                                         QSRepositoryCpp::CascadeReferences);
+
+        CHECK(deletedIds.size() == 2);
+        CHECK(repo.getObject(leaf->getUuidStr()) == leaf);
+    }
+
+    SECTION("Deletion is a single undo command") {
+        repo.getUndoHistory()->setEnabled(true);
+        repo.deleteObject(referrer->getUuidStr(), QSRepositoryCpp::CascadeReferences);
+
+        REQUIRE(repo.getUndoHistory()->undo());
+        CHECK(repo.getObject(referrer->getUuidStr()) == referrer);
+        CHECK(repo.getObject(leaf->getUuidStr()) == leaf);
+        CHECK_FALSE(repo.getUndoHistory()->canUndo());
+    }
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch.hpp>
+
+#include "QtQuickStream/Core/QSRepositoryFile.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+
+/*! ***********************************************************************************************
+ * Tests of QSRepositoryFile (the engine-free file access used by qqstool)
+ * ************************************************************************************************/
+
+namespace {
+
+QString hexHashString(const QString &str)
+{
+    return QString::fromLatin1(QCryptographicHash::hash(str.toUtf8(), QCryptographicHash::Md5)
+                                   .toHex());
+}
+
+//! Writes a JSON repository file with the given entries
+bool writeJsonFile(const QString &fileName, const QVariantMap &entries)
+{
+    QFile file(fileName);
+
+    return file.open(QFile::WriteOnly)
+        && file.write(QJsonDocument::fromVariant(entries).toJson()) > 0;
+}
+
+}
+
+TEST_CASE("Version numbers", "[qqstool]")
+{
+    CHECK(QSRepositoryFile::versionNumber("1.2.3")  == 10203);
+    CHECK(QSRepositoryFile::versionNumber("10.0.1") == 100001);
+    CHECK(QSRepositoryFile::versionNumber("2")      == 20000);
+
+    SECTION("Files need at least the minimum version") {
+        CHECK(QSRepositoryFile::isSupportedVersion("1.2.0", "1.2.0"));
+        CHECK(QSRepositoryFile::isSupportedVersion("1.10.0", "1.9.0"));
+        CHECK_FALSE(QSRepositoryFile::isSupportedVersion("1.1.9", "1.2.0"));
+        CHECK_FALSE(QSRepositoryFile::isSupportedVersion("", "1.0.0"));
+    }
+
+    SECTION("Files must not have a higher major version") {
+        CHECK(QSRepositoryFile::isApplicationVersion("2.5.0", "2.0.0"));
+        CHECK(QSRepositoryFile::isApplicationVersion("1.0.0", "2.0.0"));
+        CHECK_FALSE(QSRepositoryFile::isApplicationVersion("3.0.0", "2.9.9"));
+
+        // Major versions are compared as numbers, not strings
+        CHECK(QSRepositoryFile::isApplicationVersion("9.0.0", "10.0.0"));
+        CHECK_FALSE(QSRepositoryFile::isApplicationVersion("10.0.0", "9.0.0"));
+        CHECK_FALSE(QSRepositoryFile::isApplicationVersion("", "1.0.0"));
+    }
+}
+
+TEST_CASE("Repository files are checked and compacted without instantiating objects", "[qqstool]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString fileName = dir.filePath("repo.json");
+
+    const QVariantMap entries {
+        { QSRepositoryFile::rootKey,    "qqs:/{root}" },
+        { QSRepositoryFile::versionKey, "2.1.0" },
+        { hexHashString(QSRepositoryFile::applicationKey), hexHashString("App") },
+        { "{root}",        QVariantMap { { "qsType", "Node" }, { "child", "qqs:/{child}" } } },
+        { "{child}",       QVariantMap { { "qsType", "Node" }, { "links", QVariantList { "qqs:/{gone}" } } } },
+        { "{unreachable}", QVariantMap { { "qsType", "Node" } } }
+    };
+    REQUIRE(writeJsonFile(fileName, entries));
+
+    QSRepositoryFile repoFile;
+    QString          errorString;
+    REQUIRE(repoFile.read(fileName, &errorString));
+
+    CHECK(repoFile.format() == QSRepositoryFile::Json);
+    CHECK(repoFile.rootId() == "{root}");
+    CHECK(repoFile.objectIds().size() == 3);
+
+    SECTION("Header") {
+        QStringList errors;
+
+        CHECK(repoFile.checkHeader("App", "2.0.0", "2.0.0", errors));
+        CHECK(errors.isEmpty());
+
+        CHECK_FALSE(repoFile.checkHeader("Other", "2.0.0", "2.0.0", errors));
+        CHECK_FALSE(repoFile.checkHeader("App", "1.0.0", "1.0.0", errors));
+        CHECK_FALSE(repoFile.checkHeader("App", "2.0.0", "2.2.0", errors));
+        CHECK(errors.size() == 3);
+    }
+
+    SECTION("References") {
+        CHECK(repoFile.findUnreachable() == QStringList { "{unreachable}" });
+        CHECK(repoFile.findDangling() == QStringList { "{gone}" });
+        CHECK(repoFile.statistics().value("references").toInt() == 2);
+    }
+
+    SECTION("Compacting and converting") {
+        CHECK(repoFile.compact() == QStringList { "{unreachable}" });
+
+        const QString indexedFileName = dir.filePath("repo.qqs");
+        REQUIRE(repoFile.write(indexedFileName, QSRepositoryFile::Indexed));
+
+        QSRepositoryFile indexedFile;
+        REQUIRE(indexedFile.read(indexedFileName));
+
+        CHECK(indexedFile.format() == QSRepositoryFile::Indexed);
+        CHECK(indexedFile.rootId() == "{root}");
+        CHECK(indexedFile.objectIds().size() == 2);
+        CHECK(indexedFile.object("{child}") == repoFile.object("{child}"));
+    }
+
+    SECTION("Invalid files") {
+        const QString invalidFileName = dir.filePath("invalid.json");
+        QFile invalidFile(invalidFileName);
+        REQUIRE(invalidFile.open(QFile::WriteOnly));
+        invalidFile.write("{ \"root\": ");
+        invalidFile.close();
+
+        CHECK_FALSE(QSRepositoryFile().read(invalidFileName, &errorString));
+        CHECK_FALSE(errorString.isEmpty());
+    }
+}
@@ -0,0 +1,160 @@
+#include <catch2/catch.hpp>
+
+#include "TestObjects.h"
+#include "QtQuickStream/Core/QSSchema.h"
+
+/*! ***********************************************************************************************
+ * Tests of compile-time schemas (QSSchema): types with a schema must be stored exactly like the
+ * same type without schema
+ * ************************************************************************************************/
+
+//! Properties shared by the type with and the type without schema
+class SchemaFieldsObject : public QSObjectCpp
+{
+    Q_OBJECT
+    Q_PROPERTY(int              value       MEMBER m_value          NOTIFY valueChanged)
+    Q_PROPERTY(QString          label       MEMBER m_label          NOTIFY labelChanged)
+    Q_PROPERTY(double           ratio       MEMBER m_ratio          NOTIFY ratioChanged)
+    Q_PROPERTY(Qt::Orientation  orientation MEMBER m_orientation    NOTIFY orientationChanged)
+    Q_PROPERTY(QSObjectCpp     *target      MEMBER m_target         NOTIFY targetChanged)
+
+public:
+    using QSObjectCpp::QSObjectCpp;
+
+    int              m_value        = 0;
+    QString          m_label;
+    double           m_ratio        = 0.5;
+    Qt::Orientation  m_orientation  = Qt::Horizontal;
+    QSObjectCpp     *m_target       = nullptr;
+
+signals:
+    void valueChanged();
+    void labelChanged();
+    void ratioChanged();
+    void orientationChanged();
+    void targetChanged();
+};
+
+class SchemaTestObject : public SchemaFieldsObject
+{
+    Q_OBJECT
+
+public:
+    using SchemaFieldsObject::SchemaFieldsObject;
+};
+
+class GenericTestObject : public SchemaFieldsObject
+{
+    Q_OBJECT
+
+public:
+    using SchemaFieldsObject::SchemaFieldsObject;
+};
+
+QS_SCHEMA(SchemaTestObject,
+    QS_FIELD(value,       m_value,       valueChanged),
+    QS_FIELD(label,       m_label,       labelChanged),
+    QS_FIELD(ratio,       m_ratio,       ratioChanged),
+    QS_FIELD(orientation, m_orientation, orientationChanged),
+    QS_FIELD(target,      m_target,      targetChanged))
+
+namespace {
+
+void registerSchema()
+{
+    static const bool isRegistered = [] {
+        QSSchema::registerType<SchemaTestObject>();
+        return true;
+    }();
+    Q_UNUSED(isRegistered)
+}
+
+//! Sets the same state on an object with or without schema
+void setState(SchemaFieldsObject *qsObject, QSObjectCpp *target)
+{
+    qsObject->setProperty("value",       42);
+    qsObject->setProperty("label",       "label");
+    qsObject->setProperty("ratio",       0.25);
+    qsObject->setProperty("orientation", QVariant::fromValue(Qt::Vertical));
+    qsObject->setProperty("target",      QVariant::fromValue(target));
+}
+
+//! Returns the stored properties without the type name (the only expected difference)
+QVariantMap storedProps(const QObject *object)
+{
+    QVariantMap qsProps = QSSerializerCpp::getQSProps(object);
+    qsProps.remove("qsType");
+
+    return qsProps;
+}
+
+}
+
+TEST_CASE("Schemas store the same properties as the generic path", "[schema]")
+{
+    registerSchema();
+
+    TestRepository     repo;
+    TestObject        *target  = createObject(repo);
+    SchemaTestObject  *schema  = createObject<SchemaTestObject>(repo);
+    GenericTestObject *generic = createObject<GenericTestObject>(repo);
+
+    QSSerializerCpp serializer;
+    REQUIRE(serializer.hasSchema(schema));
+    REQUIRE_FALSE(serializer.hasSchema(generic));
+
+    SECTION("Default values") {
+        CHECK(storedProps(schema) == storedProps(generic));
+    }
+
+    SECTION("Changed values and references") {
+        setState(schema,  target);
+        setState(generic, target);
+
+        CHECK(storedProps(schema) == storedProps(generic));
+        CHECK(QSSerializerCpp::toCompactJson(storedProps(schema))
+              == QSSerializerCpp::toCompactJson(storedProps(generic)));
+        CHECK(serializer.getSchemaProps(schema) == QSSerializerCpp::getQSProps(schema));
+        CHECK(serializer.getSchemaProps(generic).isEmpty());
+    }
+}
+
+TEST_CASE("Schemas apply the properties stored by the generic path", "[schema]")
+{
+    registerSchema();
+
+    TestRepository     repo;
+    TestObject        *target  = createObject(repo);
+    SchemaTestObject  *schema  = createObject<SchemaTestObject>(repo);
+    GenericTestObject *generic = createObject<GenericTestObject>(repo);
+
+    setState(generic, target);
+
+    QSSerializerCpp serializer;
+    const QVariantMap remainingProps = serializer.applySchemaProps(schema,
+                                                                   QSSerializerCpp::getQSProps(generic));
+
+    CHECK(schema->m_value       == 42);
+    CHECK(schema->m_label       == "label");
+    CHECK(schema->m_ratio       == 0.25);
+    CHECK(schema->m_orientation == Qt::Vertical);
+
+    // References and the availability are left for the generic path
+    CHECK(remainingProps.keys() == QStringList { "qsIsAvailable", "target" });
+}
+
+TEST_CASE("The repo observes schema fields", "[schema]")
+{
+    registerSchema();
+
+    TestRepository    repo;
+    SchemaTestObject *schema = createObject<SchemaTestObject>(repo);
+
+    const QString hash = repo.getContentHash(schema->getUuidStr());
+
+    schema->setProperty("label", "changed");
+
+    CHECK(repo.getContentHash(schema->getUuidStr()) != hash);
+}
+
+#include "test_schema.moc"
@@ -0,0 +1,60 @@
+#include <catch2/catch.hpp>
+
+#include "TestObjects.h"
+#include "QtQuickStream/Core/QSSerializerCpp.h"
+
+#include <QDateTime>
+#include <QRect>
+#include <QSize>
+
+/*! ***********************************************************************************************
+ * Tests of QSSerializerCpp::isEqualValue() (used to only write properties that really changed)
+ * ************************************************************************************************/
+
+TEST_CASE("Values are compared structurally", "[serializer]")
+{
+    SECTION("Numbers (JS only knows doubles)") {
+        CHECK(QSSerializerCpp::isEqualValue(1, 1.0));
+        CHECK_FALSE(QSSerializerCpp::isEqualValue(1, 1.5));
+    }
+
+    SECTION("Arrays and maps") {
+        const QVariantList list { 1, "a", QVariantList { 2, 3 } };
+        const QVariantMap  map  { { "x", 1 }, { "y", list } };
+
+        CHECK(QSSerializerCpp::isEqualValue(list, QVariantList { 1.0, "a", QVariantList { 2, 3.0 } }));
+        CHECK_FALSE(QSSerializerCpp::isEqualValue(list, QVariantList { 1, "a" }));
+
+        CHECK(QSSerializerCpp::isEqualValue(map, QVariantMap { { "y", list }, { "x", 1.0 } }));
+        CHECK_FALSE(QSSerializerCpp::isEqualValue(map, QVariantMap { { "x", 1 }, { "z", list } }));
+    }
+
+    SECTION("Geometry types against their floating point variants") {
+        CHECK(QSSerializerCpp::isEqualValue(QSize(2, 3), QSizeF(2, 3)));
+        CHECK(QSSerializerCpp::isEqualValue(QRect(0, 0, 2, 3), QRectF(0, 0, 2, 3)));
+        CHECK_FALSE(QSSerializerCpp::isEqualValue(QSize(2, 3), QSizeF(2, 3.5)));
+    }
+
+    SECTION("Dates against milliseconds since epoch") {
+        const QDateTime dateTime = QDateTime::fromMSecsSinceEpoch(1700000000000);
+
+        CHECK(QSSerializerCpp::isEqualValue(dateTime, double(1700000000000)));
+        CHECK_FALSE(QSSerializerCpp::isEqualValue(dateTime, double(1700000000001)));
+    }
+
+    SECTION("Null values") {
+        CHECK(QSSerializerCpp::isEqualValue(QVariant(), QVariant::fromValue<QObject*>(nullptr)));
+        CHECK_FALSE(QSSerializerCpp::isEqualValue(QVariant(), 0));
+    }
+}
+
+TEST_CASE("Objects are compared by identity", "[serializer]")
+{
+    TestRepository repo;
+    TestObject *first  = createObject(repo, 1);
+    TestObject *second = createObject(repo, 1);
+
+    CHECK(QSSerializerCpp::isEqualValue(QVariant::fromValue(first), QVariant::fromValue(first)));
+    CHECK_FALSE(QSSerializerCpp::isEqualValue(QVariant::fromValue(first), QVariant::fromValue(second)));
+    CHECK_FALSE(QSSerializerCpp::isEqualValue(QVariant::fromValue(first), QVariant()));
+}
@@ -0,0 +1,66 @@
+#include <catch2/catch.hpp>
+
+#include "TestObjects.h"
+
+/*! ***********************************************************************************************
+ * Tests of QSRepositoryCpp::snapshot()
+ * ************************************************************************************************/
+
+TEST_CASE("Snapshots share unchanged objects across revisions", "[snapshot]")
+{
+    TestRepository repo;
+    TestObject *changed   = createObject(repo, 1);
+    TestObject *unchanged = createObject(repo, 2);
+
+    const QSRepositorySnapshot before = repo.snapshot();
+
+    REQUIRE(before.size() == 2);
+    REQUIRE(before.object(changed->getUuidStr()).value("value").toInt() == 1);
+
+    SECTION("Nothing is serialized again without changes") {
+        const QSRepositorySnapshot again = repo.snapshot();
+
+        CHECK(again.getRevision() == before.getRevision());
+        CHECK(again.objectData(changed->getUuidStr())   == before.objectData(changed->getUuidStr()));
+        CHECK(again.objectData(unchanged->getUuidStr()) == before.objectData(unchanged->getUuidStr()));
+    }
+
+    SECTION("Only changed objects are serialized again") {
+        changed->setProperty("value", 10);
+
+        const QSRepositorySnapshot after = repo.snapshot();
+
+        CHECK(after.getRevision() > before.getRevision());
+        CHECK(after.objectData(unchanged->getUuidStr()) == before.objectData(unchanged->getUuidStr()));
+        CHECK(after.objectData(changed->getUuidStr())   != before.objectData(changed->getUuidStr()));
+
+        // Older snapshots are immutable
+        CHECK(before.object(changed->getUuidStr()).value("value").toInt() == 1);
+        CHECK(after.object(changed->getUuidStr()).value("value").toInt()  == 10);
+    }
+
+    SECTION("Deleted objects are dropped") {
+        const QString uuidStr = changed->getUuidStr();
+        repo.delObject(uuidStr);
+
+        const QSRepositorySnapshot after = repo.snapshot();
+
+        CHECK_FALSE(after.contains(uuidStr));
+        CHECK(after.size() == 1);
+        CHECK(before.contains(uuidStr));
+    }
+}
+
+TEST_CASE("Snapshots reference other objects by URL", "[snapshot]")
+{
+    TestRepository repo;
+    TestObject *referrer = createObject(repo);
+    TestObject *target   = createObject(repo);
+
+    referrer->setProperty("target", QVariant::fromValue<QSObjectCpp*>(target));
+
+    const QSRepositorySnapshot snapshot = repo.snapshot();
+    const QString targetUrl = snapshot.object(referrer->getUuidStr()).value("target").toString();
+
+    CHECK(targetUrl.endsWith(target->getUuidStr()));
+}
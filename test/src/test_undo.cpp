@@ -0,0 +1,115 @@
+#include <catch2/catch.hpp>
+
+#include "TestObjects.h"
+
+/*! ***********************************************************************************************
+ * Tests of QSUndoHistoryCpp
+ * ************************************************************************************************/
+
+TEST_CASE("Property changes can be undone and redone", "[undo]")
+{
+    TestRepository    repo;
+    TestObject       *qsObject = createObject(repo, 1);
+    QSUndoHistoryCpp *history  = repo.getUndoHistory();
+
+    history->setEnabled(true);
+    REQUIRE_FALSE(history->canUndo());
+
+    qsObject->setProperty("value", 2);
+    qsObject->setProperty("label", "changed");
+
+    REQUIRE(history->canUndo());
+
+    SECTION("Step by step") {
+        REQUIRE(history->undo());
+        CHECK(qsObject->property("label").toString().isEmpty());
+        CHECK(qsObject->property("value").toInt() == 2);
+
+        REQUIRE(history->undo());
+        CHECK(qsObject->property("value").toInt() == 1);
+        CHECK_FALSE(history->canUndo());
+
+        REQUIRE(history->redo());
+        REQUIRE(history->redo());
+        CHECK(qsObject->property("value").toInt() == 2);
+        CHECK(qsObject->property("label").toString() == "changed");
+        CHECK_FALSE(history->canRedo());
+    }
+
+    SECTION("Commands group changes") {
+        history->beginCommand("Reset");
+        qsObject->setProperty("value", 0);
+        qsObject->setProperty("label", QString());
+        history->endCommand();
+
+        CHECK(history->getUndoText() == "Reset");
+
+        REQUIRE(history->undo());
+        CHECK(qsObject->property("value").toInt() == 2);
+        CHECK(qsObject->property("label").toString() == "changed");
+    }
+
+    SECTION("New changes drop redoable commands") {
+        REQUIRE(history->undo());
+        qsObject->setProperty("value", 3);
+
+        CHECK_FALSE(history->canRedo());
+    }
+}
+
+TEST_CASE("Additions and deletions can be undone and redone", "[undo]")
+{
+    TestRepository    repo;
+    QSUndoHistoryCpp *history = repo.getUndoHistory();
+
+    history->setEnabled(true);
+
+    TestObject   *qsObject = createObject(repo, 1);
+    const QString uuidStr  = qsObject->getUuidStr();
+
+    REQUIRE(history->undo());
+    CHECK(repo.getObject(uuidStr) == nullptr);
+
+    REQUIRE(history->redo());
+    CHECK(repo.getObject(uuidStr) == qsObject);
+
+    repo.delObject(uuidStr);
+    REQUIRE(history->undo());
+    CHECK(repo.getObject(uuidStr) == qsObject);
+}
+
+TEST_CASE("The byte budget only limits the recorded commands", "[undo]")
+{
+    TestRepository    repo;
+    TestObject       *qsObject = createObject(repo);
+    QSUndoHistoryCpp *history  = repo.getUndoHistory();
+
+    for (int i = 0; i < 1000; ++i) {
+        createObject(repo, i)->setProperty("label", QString(100, QChar('x')));
+    }
+
+    history->setEnabled(true);
+
+    // The last known values of a large repo exceed the budget on their own
+    REQUIRE(history->getCapturedBytes() > 0);
+    history->setByteBudget(history->getCapturedBytes() / 2);
+
+    for (int i = 1; i <= 3; ++i) {
+        qsObject->setProperty("value", i);
+    }
+
+    CHECK(history->getUsedBytes() <= history->getByteBudget());
+    CHECK(history->undo());
+    CHECK(history->undo());
+    CHECK(history->undo());
+    CHECK(qsObject->property("value").toInt() == 0);
+
+    SECTION("Oldest commands are dropped") {
+        history->setByteBudget(1);
+
+        CHECK(history->canRedo());
+        CHECK_FALSE(history->canUndo());
+        CHECK(history->redo());
+        CHECK_FALSE(history->canRedo());
+    }
+}
@@ -0,0 +1,99 @@
+#include <catch2/catch.hpp>
+
+#include "QtQuickStream/Core/QSSerializerCpp.h"
+#include "QtQuickStream/Core/QSValueCodecs.h"
+
+#include <QColor>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QLineF>
+#include <QMargins>
+#include <QRectF>
+#include <QUrl>
+#include <QVector2D>
+#include <QVector3D>
+
+/*! ***********************************************************************************************
+ * Tests of QSValueCodecs (tagged value types)
+ * ************************************************************************************************/
+
+namespace {
+
+//! Encodes value, stores it as JSON (as files do) and decodes it again
+QVariant roundTrip(const QVariant &value)
+{
+    const QVariant qsValue = QSValueCodecs::encode(value);
+    const QVariant stored  = QJsonDocument::fromJson(QSSerializerCpp::toCompactJson(qsValue))
+                                 .toVariant();
+
+    return QSValueCodecs::decode(stored.toMap());
+}
+
+}
+
+TEST_CASE("Built-in codecs round-trip their values", "[codecs]")
+{
+    SECTION("Vectors") {
+        CHECK(roundTrip(QVector2D(1.5f, -2.0f)) == QVariant(QVector2D(1.5f, -2.0f)));
+        CHECK(roundTrip(QVector3D(1.0f, 2.0f, 3.25f)) == QVariant(QVector3D(1.0f, 2.0f, 3.25f)));
+    }
+
+    SECTION("Geometry (integer types are restored as floating point types)") {
+        CHECK(roundTrip(QPointF(1.5, 2.5)).toPointF() == QPointF(1.5, 2.5));
+        CHECK(roundTrip(QPoint(3, 4)).toPointF()      == QPointF(3, 4));
+        CHECK(roundTrip(QSize(5, 6)).toSizeF()        == QSizeF(5, 6));
+        CHECK(roundTrip(QRectF(1, 2, 3, 4)).toRectF() == QRectF(1, 2, 3, 4));
+    }
+
+    SECTION("Values stored as string") {
+        const QDateTime dateTime = QDateTime::fromMSecsSinceEpoch(1700000000123);
+
+        CHECK(roundTrip(QColor(10, 20, 30, 40)).value<QColor>() == QColor(10, 20, 30, 40));
+        CHECK(roundTrip(dateTime).toDateTime() == dateTime);
+        CHECK(roundTrip(QUrl("qrc:/file.qml")).toUrl() == QUrl("qrc:/file.qml"));
+    }
+
+    SECTION("Values are tagged with their type") {
+        const QVariantMap qsValue = QSValueCodecs::encode(QVector2D(1, 2)).toMap();
+
+        CHECK(QSValueCodecs::isEncoded(qsValue));
+        CHECK(qsValue.value(QSValueCodecs::typeKey).toString() == "vector2d");
+        CHECK(qsValue.value("x").toDouble() == 1.0);
+    }
+}
+
+TEST_CASE("Enums are stored with their key", "[codecs]")
+{
+    const QMetaEnum metaEnum = QMetaEnum::fromType<Qt::Orientation>();
+    const QVariantMap qsValue = QSValueCodecs::encodeEnum(metaEnum, Qt::Vertical).toMap();
+
+    CHECK(qsValue.value("key").toString() == "Vertical");
+    CHECK(QSValueCodecs::decode(qsValue).toInt() == Qt::Vertical);
+}
+
+TEST_CASE("Values without codec or with missing fields are not converted", "[codecs]")
+{
+    CHECK_FALSE(QSValueCodecs::hasCodec(QMetaType::fromType<QMargins>()));
+    CHECK_FALSE(QSValueCodecs::encode(QMargins(1, 2, 3, 4)).isValid());
+
+    CHECK_FALSE(QSValueCodecs::decode({ { QSValueCodecs::typeKey, "vector2d" }, { "x", 1 } }).isValid());
+    CHECK_FALSE(QSValueCodecs::decode({ { QSValueCodecs::typeKey, "unknown" } }).isValid());
+    CHECK_FALSE(QSValueCodecs::decode({ { "x", 1 } }).isValid());
+}
+
+TEST_CASE("Applications can register codecs", "[codecs]")
+{
+    QSValueCodecs::registerCodec(
+        QMetaType::fromType<QLineF>(), "test-line",
+        [](const QVariant &value) -> QVariantMap {
+            const QLineF line = value.toLineF();
+            return { { "x1", line.x1() }, { "y1", line.y1() }, { "x2", line.x2() }, { "y2", line.y2() } };
+        },
+        [](const QVariantMap &fields) -> QVariant {
+            return QLineF(fields.value("x1").toDouble(), fields.value("y1").toDouble(),
+                          fields.value("x2").toDouble(), fields.value("y2").toDouble());
+        });
+
+    CHECK(QSValueCodecs::hasCodec(QMetaType::fromType<QLineF>()));
+    CHECK(roundTrip(QLineF(1, 2, 3, 4)).toLineF() == QLineF(1, 2, 3, 4));
+}
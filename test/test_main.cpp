@@ -1 +1,14 @@
-#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch.hpp>
+
+#include <QCoreApplication>
+
+/*! Runs all tests with an application object, as repositories rely on queued connections and
+ *  deferred deletion
+ * ************************************************************************************************/
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    return Catch::Session().run(argc, argv);
+}
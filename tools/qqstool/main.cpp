@@ -0,0 +1,424 @@
+#include "QSMutationReplayer.h"
+#include "QSRepositoryCpp.h"
+#include "QSRepositoryFile.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QThreadPool>
+
+#include <functional>
+
+/*! ***********************************************************************************************
+ * qqstool processes stored repositories (JSON or indexed files) without a QML engine:
+ *
+ *      qqstool validate [--app NAME] [--app-version V] [--min-version V] FILES...
+ *      qqstool convert  --format json|indexed [--output DIR] FILES...
+ *      qqstool compact  [--format json|indexed] [--output DIR] [--dry-run] FILES...
+ *      qqstool stats    [--json] FILES...
+ *      qqstool replay   [--json] [--baseline FILE] [--tolerance PERCENT] TRACES...
+ *
+ * Files are processed in parallel (--jobs, default: all cores; replay: 1 for stable timings). The
+ * exit code is 0 if all files succeeded, 1 if any file failed and 2 for usage errors.
+ *
+ * replay re-executes mutation traces (see QSMutationRecorderCpp) against a fresh repo and reports
+ * throughput and latencies per operation kind. With --baseline (the output of 'replay --json'), a
+ * trace fails if the mean or p99 latency of any kind exceeds the baseline by more than --tolerance.
+ * ************************************************************************************************/
+
+namespace {
+
+/*! Outcome of a command for a single file
+ * ************************************************************************************************/
+struct Result
+{
+    bool        ok = true;
+    QStringList messages;
+    QVariantMap stats;
+
+    Result &fail(const QString &message)
+    {
+        ok = false;
+        messages.append(message);
+        return *this;
+    }
+};
+
+using Command = std::function<Result(const QString &fileName)>;
+
+/*! Returns the format given by --format (or fallback if not given), false if unknown
+ * ************************************************************************************************/
+bool parseFormat(const QCommandLineParser &parser, QSRepositoryFile::Format fallback,
+                 QSRepositoryFile::Format &format)
+{
+    const QString formatName = parser.value(QStringLiteral("format"));
+
+    if (formatName.isEmpty())                   { format = fallback;                  return true; }
+    if (formatName == QLatin1String("json"))    { format = QSRepositoryFile::Json;    return true; }
+    if (formatName == QLatin1String("indexed")) { format = QSRepositoryFile::Indexed; return true; }
+
+    return false;
+}
+
+/*! Returns where to write fileName in format: in --output (or next to the file), and with the
+ *  suffix of the format if it changes
+ * ************************************************************************************************/
+QString outputFileName(const QCommandLineParser &parser, const QString &fileName,
+                       QSRepositoryFile::Format inputFormat, QSRepositoryFile::Format format)
+{
+    const QFileInfo fileInfo(fileName);
+    const QDir      outputDir(parser.isSet(QStringLiteral("output"))
+                              ? parser.value(QStringLiteral("output"))
+                              : fileInfo.absolutePath());
+
+    const QString outputName = (format == inputFormat)
+                             ? fileInfo.fileName()
+                             : fileInfo.completeBaseName()
+                               + (format == QSRepositoryFile::Indexed ? QStringLiteral(".qqsidx")
+                                                                      : QStringLiteral(".json"));
+
+    return outputDir.filePath(outputName);
+}
+
+/*! Checks header (application, version), root object and references
+ * ************************************************************************************************/
+Result validateFile(const QCommandLineParser &parser, const QString &fileName)
+{
+    Result           result;
+    QSRepositoryFile repoFile;
+    QString          error;
+
+    if (!repoFile.read(fileName, &error)) { return result.fail(error); }
+
+    result.ok = repoFile.checkHeader(parser.value(QStringLiteral("app")),
+                                     parser.value(QStringLiteral("app-version")),
+                                     parser.value(QStringLiteral("min-version")),
+                                     result.messages);
+
+    if (repoFile.rootId().isEmpty()) {
+        result.fail(QStringLiteral("No root object"));
+    } else if (!repoFile.objectIds().contains(repoFile.rootId())) {
+        result.fail(QStringLiteral("Missing root object %1").arg(repoFile.rootId()));
+    }
+
+    const QStringList danglingIds = repoFile.findDangling();
+    if (!danglingIds.isEmpty()) {
+        result.messages.append(QStringLiteral("warning: %1 dangling reference(s), e.g. %2")
+                                   .arg(danglingIds.size()).arg(danglingIds.first()));
+    }
+
+    return result;
+}
+
+/*! Writes the file in another format
+ * ************************************************************************************************/
+Result convertFile(const QCommandLineParser &parser, const QString &fileName,
+                   QSRepositoryFile::Format format)
+{
+    Result           result;
+    QSRepositoryFile repoFile;
+    QString          error;
+
+    if (!repoFile.read(fileName, &error)) { return result.fail(error); }
+
+    const QString outputName = outputFileName(parser, fileName, repoFile.format(), format);
+    if (!repoFile.write(outputName, format)) {
+        return result.fail(QStringLiteral("Could not write %1").arg(outputName));
+    }
+
+    result.messages.append(QStringLiteral("-> %1").arg(outputName));
+
+    return result;
+}
+
+/*! Removes all objects that cannot be reached from the root object
+ * ************************************************************************************************/
+Result compactFile(const QCommandLineParser &parser, const QString &fileName, bool hasFormat,
+                   QSRepositoryFile::Format format)
+{
+    Result           result;
+    QSRepositoryFile repoFile;
+    QString          error;
+
+    if (!repoFile.read(fileName, &error)) { return result.fail(error); }
+
+    if (!repoFile.objectIds().contains(repoFile.rootId())) {
+        return result.fail(QStringLiteral("Missing root object, nothing removed"));
+    }
+
+    const QStringList removedIds = repoFile.compact();
+    result.messages.append(QStringLiteral("%1 unreachable object(s)").arg(removedIds.size()));
+
+    if (parser.isSet(QStringLiteral("dry-run"))) { return result; }
+
+    const QSRepositoryFile::Format outputFormat = hasFormat ? format : repoFile.format();
+    const QString outputName = outputFileName(parser, fileName, repoFile.format(), outputFormat);
+
+    // Nothing to write when compacting in place without changes
+    if (removedIds.isEmpty() && outputName == QFileInfo(fileName).absoluteFilePath()
+            && outputFormat == repoFile.format()) {
+        return result;
+    }
+
+    if (!repoFile.write(outputName, outputFormat)) {
+        return result.fail(QStringLiteral("Could not write %1").arg(outputName));
+    }
+
+    result.messages.append(QStringLiteral("-> %1").arg(outputName));
+
+    return result;
+}
+
+/*! Collects statistics of the file
+ * ************************************************************************************************/
+Result statsFile(const QString &fileName)
+{
+    Result           result;
+    QSRepositoryFile repoFile;
+    QString          error;
+
+    if (!repoFile.read(fileName, &error)) { return result.fail(error); }
+
+    result.stats = repoFile.statistics();
+
+    return result;
+}
+
+/*! Replays a mutation trace, and compares latencies to the baseline of the trace (if any)
+ * ************************************************************************************************/
+Result replayFile(const QString &fileName, const QVariantMap &baseline, double tolerance)
+{
+    Result             result;
+    QSMutationReplayer replayer;
+    QString            error;
+
+    if (!replayer.load(fileName, &error)) { return result.fail(error); }
+
+    QSRepositoryCpp repo;
+    result.stats = replayer.replay(&repo);
+
+    const QVariantMap kinds         = result.stats.value(QStringLiteral("kinds")).toMap();
+    const QVariantMap baselineKinds = baseline.value(fileName).toMap()
+                                              .value(QStringLiteral("kinds")).toMap();
+
+    for (auto it = kinds.cbegin(); it != kinds.cend(); ++it) {
+        const QVariantMap kind         = it.value().toMap();
+        const QVariantMap baselineKind = baselineKinds.value(it.key()).toMap();
+
+        for (const QString &key : { QStringLiteral("meanUs"), QStringLiteral("p99Us") }) {
+            if (!baselineKind.contains(key)) { continue; }
+
+            const double value = kind.value(key).toDouble();
+            const double limit = baselineKind.value(key).toDouble() * (1.0 + tolerance / 100.0);
+
+            if (value > limit) {
+                result.fail(QStringLiteral("%1 %2 %3 exceeds baseline %4")
+                                .arg(it.key(), key).arg(value, 0, 'f', 2)
+                                .arg(baselineKind.value(key).toDouble(), 0, 'f', 2));
+            }
+        }
+    }
+
+    return result;
+}
+
+/*! Returns a single line summary of the statistics (stats) or results (replay) of a file
+ * ************************************************************************************************/
+QString summary(const QVariantMap &stats)
+{
+    if (stats.contains(QStringLiteral("kinds"))) {
+        QStringList kindSummaries;
+        const QVariantMap kinds = stats.value(QStringLiteral("kinds")).toMap();
+        for (auto it = kinds.cbegin(); it != kinds.cend(); ++it) {
+            const QVariantMap kind = it.value().toMap();
+            kindSummaries.append(QStringLiteral("%1 x%2 p50 %3us p99 %4us")
+                                     .arg(it.key())
+                                     .arg(kind.value(QStringLiteral("count")).toLongLong())
+                                     .arg(kind.value(QStringLiteral("p50Us")).toDouble(), 0, 'f', 1)
+                                     .arg(kind.value(QStringLiteral("p99Us")).toDouble(), 0, 'f', 1));
+        }
+
+        return QStringLiteral("%1 operation(s) in %2 ms (%3 ops/s), %4")
+                   .arg(stats.value(QStringLiteral("operations")).toLongLong())
+                   .arg(stats.value(QStringLiteral("elapsedMs")).toDouble(), 0, 'f', 1)
+                   .arg(stats.value(QStringLiteral("opsPerSecond")).toDouble(), 0, 'f', 0)
+                   .arg(kindSummaries.join(QStringLiteral(", ")));
+    }
+
+    return QStringLiteral("%1, %2 bytes, %3 object(s) of %4 type(s), %5 unreachable, %6 dangling")
+               .arg(stats.value(QStringLiteral("format")).toString())
+               .arg(stats.value(QStringLiteral("fileSize")).toLongLong())
+               .arg(stats.value(QStringLiteral("objects")).toLongLong())
+               .arg(stats.value(QStringLiteral("types")).toMap().size())
+               .arg(stats.value(QStringLiteral("unreachable")).toLongLong())
+               .arg(stats.value(QStringLiteral("dangling")).toLongLong());
+}
+
+/*! Runs command for all files on jobs threads, results are in order of files
+ * ************************************************************************************************/
+QList<Result> runParallel(const QStringList &fileNames, const Command &command, int jobs)
+{
+    QList<Result> results(fileNames.size());
+
+    QThreadPool threadPool;
+    if (jobs > 0) { threadPool.setMaxThreadCount(jobs); }
+
+    // Each task writes its own result only, so no locking is needed
+    Result *resultData = results.data();
+    for (qsizetype i = 0; i < fileNames.size(); ++i) {
+        threadPool.start([resultData, &fileNames, &command, i]() {
+            resultData[i] = command(fileNames.at(i));
+        });
+    }
+
+    threadPool.waitForDone();
+
+    return results;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("qqstool"));
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        QStringLiteral("Validates, converts, compacts and inspects QtQuickStream repository files."));
+    parser.addHelpOption();
+    parser.addPositionalArgument(QStringLiteral("command"),
+                                 QStringLiteral("validate, convert, compact, stats or replay"));
+    parser.addPositionalArgument(QStringLiteral("files"), QStringLiteral("Repository files"),
+                                 QStringLiteral("files..."));
+    parser.addOptions({
+        { { QStringLiteral("j"), QStringLiteral("jobs") },
+          QStringLiteral("Number of files processed in parallel (default: all cores)."),
+          QStringLiteral("count") },
+        { QStringLiteral("app"),
+          QStringLiteral("validate: application name the files must belong to."),
+          QStringLiteral("name") },
+        { QStringLiteral("app-version"),
+          QStringLiteral("validate: application version (files may not have a higher major)."),
+          QStringLiteral("version") },
+        { QStringLiteral("min-version"),
+          QStringLiteral("validate: minimum supported file version."),
+          QStringLiteral("version") },
+        { QStringLiteral("format"),
+          QStringLiteral("convert/compact: output format, json or indexed."),
+          QStringLiteral("format") },
+        { { QStringLiteral("o"), QStringLiteral("output") },
+          QStringLiteral("convert/compact: output directory (default: next to the input)."),
+          QStringLiteral("dir") },
+        { QStringLiteral("dry-run"),
+          QStringLiteral("compact: only report unreachable objects.") },
+        { QStringLiteral("json"),
+          QStringLiteral("stats/replay: print statistics/results as JSON.") },
+        { QStringLiteral("baseline"),
+          QStringLiteral("replay: results to compare with (output of 'replay --json')."),
+          QStringLiteral("file") },
+        { QStringLiteral("tolerance"),
+          QStringLiteral("replay: allowed slowdown against the baseline in percent (default: 10)."),
+          QStringLiteral("percent"), QStringLiteral("10") }
+    });
+    parser.process(app);
+
+    QStringList fileNames = parser.positionalArguments();
+    const QString commandName = fileNames.isEmpty() ? QString() : fileNames.takeFirst();
+
+    if (fileNames.isEmpty()) {
+        err << "qqstool: no files given\n\n" << parser.helpText();
+        return 2;
+    }
+
+    if (parser.isSet(QStringLiteral("output")) && !QDir().mkpath(parser.value(QStringLiteral("output")))) {
+        err << "qqstool: could not create output directory\n";
+        return 2;
+    }
+
+    QSRepositoryFile::Format format = QSRepositoryFile::Json;
+    if (!parseFormat(parser, QSRepositoryFile::Json, format)) {
+        err << "qqstool: unknown format " << parser.value(QStringLiteral("format")) << "\n";
+        return 2;
+    }
+    const bool hasFormat = parser.isSet(QStringLiteral("format"));
+
+    Command command;
+    if (commandName == QLatin1String("validate")) {
+        command = [&parser](const QString &fileName) { return validateFile(parser, fileName); };
+    } else if (commandName == QLatin1String("convert") && hasFormat) {
+        command = [&parser, format](const QString &fileName) {
+            return convertFile(parser, fileName, format);
+        };
+    } else if (commandName == QLatin1String("compact")) {
+        command = [&parser, hasFormat, format](const QString &fileName) {
+            return compactFile(parser, fileName, hasFormat, format);
+        };
+    } else if (commandName == QLatin1String("stats")) {
+        command = &statsFile;
+    } else if (commandName == QLatin1String("replay")) {
+        QVariantMap baseline;
+        if (parser.isSet(QStringLiteral("baseline"))) {
+            QFile baselineFile(parser.value(QStringLiteral("baseline")));
+            if (!baselineFile.open(QIODevice::ReadOnly)) {
+                err << "qqstool: could not read baseline " << baselineFile.fileName() << "\n";
+                return 2;
+            }
+            baseline = QJsonDocument::fromJson(baselineFile.readAll()).object().toVariantMap();
+        }
+
+        const double tolerance = parser.value(QStringLiteral("tolerance")).toDouble();
+        command = [baseline, tolerance](const QString &fileName) {
+            return replayFile(fileName, baseline, tolerance);
+        };
+    } else {
+        err << "qqstool: unknown command or missing --format\n\n" << parser.helpText();
+        return 2;
+    }
+
+    // Replays run one after the other unless requested otherwise, so timings are not distorted
+    const int jobs = (commandName == QLatin1String("replay") && !parser.isSet(QStringLiteral("jobs")))
+                   ? 1
+                   : parser.value(QStringLiteral("jobs")).toInt();
+
+    const QList<Result> results = runParallel(fileNames, command, jobs);
+
+    // Report in order of the files
+    bool        allOk = true;
+    QJsonObject statsJson;
+
+    for (qsizetype i = 0; i < results.size(); ++i) {
+        const Result  &result   = results.at(i);
+        const QString &fileName = fileNames.at(i);
+
+        allOk &= result.ok;
+
+        if (parser.isSet(QStringLiteral("json")) && result.ok) {
+            statsJson.insert(fileName, QJsonObject::fromVariantMap(result.stats));
+            continue;
+        }
+
+        QStringList details = result.messages;
+        if (!result.stats.isEmpty()) {
+            details.prepend(summary(result.stats));
+        }
+
+        (result.ok ? out : err) << (result.ok ? "OK   " : "FAIL ") << fileName
+                                << (details.isEmpty() ? QString() : ": " + details.join("; "))
+                                << "\n";
+    }
+
+    if (parser.isSet(QStringLiteral("json"))) {
+        out << QJsonDocument(statsJson).toJson(QJsonDocument::Indented);
+    }
+
+    return allOk ? 0 : 1;
+}